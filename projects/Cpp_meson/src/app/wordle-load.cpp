@@ -0,0 +1,166 @@
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief One connection to the solver started with "wordle <dir> --serve <socket>".
+ */
+class Connection {
+    int m_fd;
+    std::string m_buffer{};
+
+public:
+    explicit Connection(std::string const& socketPath)
+        : m_fd(::socket(AF_UNIX, SOCK_STREAM, 0)) {
+        auto addr = sockaddr_un();
+        addr.sun_family = AF_UNIX;
+        if (m_fd == -1 || socketPath.size() >= sizeof(addr.sun_path)) {
+            throw std::runtime_error("could not create socket for " + socketPath);
+        }
+        std::copy(socketPath.begin(), socketPath.end(), addr.sun_path);
+        if (::connect(m_fd, reinterpret_cast<sockaddr const*>(&addr), sizeof(addr)) != 0) {
+            ::close(m_fd);
+            throw std::runtime_error("could not connect to " + socketPath);
+        }
+    }
+
+    ~Connection() {
+        ::close(m_fd);
+    }
+
+    Connection(Connection const&) = delete;
+    Connection& operator=(Connection const&) = delete;
+
+    /**
+     * @brief Sends one request line and waits for the answer line.
+     */
+    std::string request(std::string const& line) {
+        auto data = std::string_view(line);
+        while (!data.empty()) {
+            auto numSent = ::send(m_fd, data.data(), data.size(), MSG_NOSIGNAL);
+            if (numSent <= 0) {
+                throw std::runtime_error("connection lost");
+            }
+            data.remove_prefix(static_cast<size_t>(numSent));
+        }
+
+        auto readBuffer = std::array<char, 4096>();
+        auto eol = m_buffer.find('\n');
+        while (eol == std::string::npos) {
+            auto numRead = ::read(m_fd, readBuffer.data(), readBuffer.size());
+            if (numRead <= 0) {
+                throw std::runtime_error("connection lost");
+            }
+            m_buffer.append(readBuffer.data(), static_cast<size_t>(numRead));
+            eol = m_buffer.find('\n');
+        }
+        auto answer = m_buffer.substr(0, eol);
+        m_buffer.erase(0, eol + 1);
+        return answer;
+    }
+};
+
+std::chrono::microseconds percentile(std::vector<std::chrono::microseconds> const& sortedLatencies, size_t percent) {
+    auto idx = (sortedLatencies.size() - 1) * percent / 100;
+    return sortedLatencies[idx];
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cout << R"(Load generator for the wordle solver daemon
+
+Usage: ./wordle-load <socket> [--connections <n>] [--requests <n>] [request]...
+
+Sends requests to "./wordle <dictionary-dir> --serve <socket>" and reports the latency. Each connection sends one request,
+waits for the answer, then sends the next. The given requests are used round robin; without any, they are read from stdin,
+one per line.
+
+Example:
+
+    ./wordle-load /tmp/wordle.sock --connections 4 --requests 200 "en weary00102" "en raise00000 mount01002"
+)";
+        return 1;
+    }
+
+    auto socketPath = std::string(argv[1]);
+    auto numConnections = size_t(1);
+    auto numRequests = size_t(100);
+    auto requests = std::vector<std::string>();
+    for (int i = 2; i < argc; ++i) {
+        auto arg = std::string_view(argv[i]);
+        if (arg == "--connections" || arg == "--requests") {
+            if (i + 1 == argc) {
+                throw std::runtime_error(std::string(arg) + " needs a value");
+            }
+            auto value = std::stoul(argv[++i]);
+            (arg == "--connections" ? numConnections : numRequests) = value;
+        } else {
+            requests.emplace_back(arg);
+        }
+    }
+    if (requests.empty()) {
+        for (auto line = std::string(); std::getline(std::cin, line);) {
+            if (!line.empty()) {
+                requests.push_back(line);
+            }
+        }
+    }
+    if (requests.empty() || numConnections == 0) {
+        throw std::runtime_error("need at least one request and one connection");
+    }
+
+    // each connection thread has its own latencies, so no locking is needed while measuring
+    auto latencies = std::vector<std::vector<std::chrono::microseconds>>(numConnections);
+    auto numErrors = std::vector<size_t>(numConnections);
+    auto threads = std::vector<std::thread>();
+    auto startTime = std::chrono::steady_clock::now();
+    for (size_t c = 0; c < numConnections; ++c) {
+        threads.emplace_back([&, c] {
+            auto connection = Connection(socketPath);
+            for (auto r = c; r < numRequests; r += numConnections) {
+                auto before = std::chrono::steady_clock::now();
+                auto answer = connection.request(requests[r % requests.size()] + '\n');
+                latencies[c].push_back(
+                    std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - before));
+                if (answer.rfind("error:", 0) == 0) {
+                    ++numErrors[c];
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    auto duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime);
+
+    auto all = std::vector<std::chrono::microseconds>();
+    auto totalErrors = size_t();
+    for (size_t c = 0; c < numConnections; ++c) {
+        all.insert(all.end(), latencies[c].begin(), latencies[c].end());
+        totalErrors += numErrors[c];
+    }
+    std::sort(all.begin(), all.end());
+
+    std::cout << all.size() << " requests (" << totalErrors << " errors) over " << numConnections << " connections in "
+              << duration.count() << " s, " << static_cast<double>(all.size()) / duration.count() << " requests/s"
+              << std::endl;
+    if (!all.empty()) {
+        std::cout << "latency p50 " << percentile(all, 50).count() << " us, p99 " << percentile(all, 99).count()
+                  << " us, max " << all.back().count() << " us" << std::endl;
+    }
+}
@@ -0,0 +1,39 @@
+#include <wordle/WordDatabase.h>
+#include <wordle/solve.h>
+
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+int main(int argc, char** argv) {
+    if (argc < 2 || argc > 3) {
+        std::cout << R"(wordle-pack - writes dictionaries into a word database
+usage: ./wordle-pack <prefix> [<output>]
+
+Reads <prefix>_allowed.txt and <prefix>_correct.txt, and writes the words in the order the search uses
+into <output>, by default <prefix>.wdb. Loading that file with ./wordle <prefix>.wdb needs no parsing,
+no sorting and no hashing.
+
+Example:
+
+    ./wordle-pack dictionaries/en
+        Writes dictionaries/en.wdb.
+)";
+        return 1;
+    }
+
+    auto prefix = std::string(argv[1]);
+    auto output = argc == 3 ? std::string(argv[2]) : prefix + ".wdb";
+
+    auto startTime = std::chrono::steady_clock::now();
+    auto [allowedWords, correctWords] = wordle::readWordLists(prefix);
+    wordle::WordDatabase::write(output, allowedWords, correctWords);
+
+    // read it back, so a broken file is noticed right away
+    auto database = wordle::WordDatabase(output);
+    auto duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime);
+    std::cout << output << ": " << database.allowed().m_size << " allowed, " << database.correct().m_size
+              << " correct words, content hash " << std::hex << database.contentHash() << std::dec << ", "
+              << duration.count() << " s" << std::endl;
+}
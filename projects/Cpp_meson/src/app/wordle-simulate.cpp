@@ -0,0 +1,201 @@
+#include <util/parallel/for_each.h>
+#include <wordle/Isa.h>
+#include <wordle/State.h>
+#include <wordle/WordSet.h>
+#include <wordle/solve.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Plays the solver against every correct word.
+ *
+ * All games start the same, and games stay together as long as they got the same feedback. So instead of playing each game
+ * separately, the games are played as a tree: one search for each set of remaining words, and the feedback of the guess
+ * splits the set into the games that continue together. Each game still gets exactly the guesses it would get when played
+ * alone.
+ */
+class Simulation {
+    // a game that takes this long has a solver that doesn't make progress
+    static constexpr size_t MaxGuesses = 20;
+
+    wordle::Dictionary const& m_dict;
+    size_t m_maxDepth;
+    std::optional<std::chrono::milliseconds> m_timeBudget;
+
+    // below the root, many small searches run at the same time
+    wordle::TranspositionTablePool m_tables{1U << 16U};
+    wordle::TranspositionTable<wordle::Result> m_rootTable{1U << 18U};
+
+    std::vector<uint8_t> m_numGuesses;
+    std::atomic<size_t> m_numSearches{};
+
+    wordle::WordId bestGuess(wordle::WordSet const& remainingCorrectWords, bool isRoot) {
+        if (remainingCorrectWords.size() == 1) {
+            auto guess = wordle::NoWordId;
+            remainingCorrectWords.forEach([&](size_t correctIdx) {
+                guess = m_dict.m_correctIds[correctIdx];
+            });
+            return guess;
+        }
+
+        ++m_numSearches;
+        auto deadline = std::optional<std::chrono::steady_clock::time_point>();
+        if (m_timeBudget) {
+            deadline = std::chrono::steady_clock::now() + *m_timeBudget;
+        }
+        if (isRoot) {
+            return wordle::solve(m_dict, remainingCorrectWords, m_rootTable, m_maxDepth, deadline, false, true).m_guessId;
+        }
+        auto table = m_tables.acquire();
+        auto guess = wordle::solve(m_dict, remainingCorrectWords, *table, m_maxDepth, deadline, false, false).m_guessId;
+        m_tables.release(std::move(table));
+        return guess;
+    }
+
+    void play(wordle::WordSet const& remainingCorrectWords, size_t numGuesses) {
+        if (numGuesses == MaxGuesses) {
+            throw std::runtime_error("no game should take " + std::to_string(MaxGuesses) + " guesses");
+        }
+        auto guess = bestGuess(remainingCorrectWords, numGuesses == 0);
+        ++numGuesses;
+
+        // the feedback each game gets for the guess decides which games stay together
+        auto const* guessCodes = m_dict.m_feedback.row(guess);
+        auto buckets = std::vector<wordle::WordSet>(wordle::NumStateCodes);
+        remainingCorrectWords.forEach([&](size_t correctIdx) {
+            buckets[guessCodes[correctIdx]].insert(correctIdx);
+        });
+
+        buckets[wordle::AllCorrectStateCode].forEach([&](size_t correctIdx) {
+            m_numGuesses[correctIdx] = static_cast<uint8_t>(numGuesses);
+        });
+        auto codes = std::vector<uint8_t>();
+        for (size_t code = 0; code < wordle::AllCorrectStateCode; ++code) {
+            if (buckets[code] == remainingCorrectWords) {
+                throw std::runtime_error("guess doesn't split the remaining words");
+            }
+            if (!buckets[code].empty()) {
+                codes.push_back(static_cast<uint8_t>(code));
+            }
+        }
+
+        // biggest first, those take longest
+        std::sort(codes.begin(), codes.end(), [&](uint8_t a, uint8_t b) {
+            return buckets[a].size() > buckets[b].size();
+        });
+        ankerl::parallel::for_each(codes.begin(), codes.end(), [&](uint8_t code) {
+            play(buckets[code], numGuesses);
+        });
+    }
+
+public:
+    Simulation(wordle::Dictionary const& dict, size_t maxDepth, std::optional<std::chrono::milliseconds> timeBudget)
+        : m_dict(dict)
+        , m_maxDepth(maxDepth)
+        , m_timeBudget(timeBudget)
+        , m_numGuesses(dict.m_correctWords.size()) {}
+
+    /**
+     * @brief Plays all games, and returns the number of guesses of each, indexed like the correct words.
+     */
+    std::vector<uint8_t> const& run() {
+        auto allCorrectWords = wordle::WordSet();
+        for (size_t correctIdx = 0; correctIdx < m_dict.m_correctWords.size(); ++correctIdx) {
+            allCorrectWords.insert(correctIdx);
+        }
+        play(allCorrectWords, 0);
+        return m_numGuesses;
+    }
+
+    size_t numSearches() const {
+        return m_numSearches;
+    }
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cout << R"(Plays the wordle solver against every correct word, and reports how many guesses it needs.
+
+Usage: ./wordle-simulate <prefix> [--max-depth <n>] [--time-budget-ms <ms>] [--force-isa <isa>]
+
+Loads <prefix>_allowed.txt and <prefix>_correct.txt. Each game feeds the state of the guess back into the solver,
+until the guess is correct. Games that got the same feedback so far have the same remaining words, so they share the
+search. --max-depth and --time-budget-ms are used for each search, like in ./wordle. The default depth is 1, so a run
+takes seconds; --max-depth 2 plays like ./wordle, but takes minutes.
+)";
+        return 1;
+    }
+
+    auto prefix = std::string(argv[1]);
+    auto maxDepth = size_t(1);
+    auto timeBudget = std::optional<std::chrono::milliseconds>();
+    for (int i = 2; i < argc; ++i) {
+        auto arg = std::string_view(argv[i]);
+        if (i + 1 == argc) {
+            throw std::runtime_error(std::string(arg) + " needs a value");
+        }
+        if (arg == "--force-isa") {
+            wordle::forceIsa(wordle::parseIsa(argv[++i]));
+        } else if (arg == "--max-depth") {
+            maxDepth = std::stoul(argv[++i]);
+        } else if (arg == "--time-budget-ms") {
+            timeBudget = std::chrono::milliseconds(std::stoul(argv[++i]));
+        } else {
+            throw std::runtime_error("unknown argument " + std::string(arg));
+        }
+    }
+    if (maxDepth == 0 || maxDepth > wordle::Fitness::MaxDepth) {
+        throw std::runtime_error("--max-depth must be between 1 and " + std::to_string(wordle::Fitness::MaxDepth));
+    }
+
+    std::cout << "instruction set: " << wordle::activeIsa() << std::endl;
+    auto dict = wordle::loadDictionary(prefix);
+
+    auto startTime = std::chrono::steady_clock::now();
+    auto simulation = Simulation(dict, maxDepth, timeBudget);
+    auto const& numGuesses = simulation.run();
+    auto duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime);
+
+    auto histogram = std::map<size_t, size_t>();
+    auto totalGuesses = size_t();
+    for (auto n : numGuesses) {
+        ++histogram[n];
+        totalGuesses += n;
+    }
+    auto worst = histogram.rbegin()->first;
+
+    std::cout << "guesses: games" << std::endl;
+    for (auto const& [n, count] : histogram) {
+        std::cout << n << ": " << count << std::endl;
+    }
+    // a few examples are enough to replay a worst case game
+    std::cout << "worst case " << worst << " guesses:";
+    auto numShown = size_t();
+    for (size_t correctIdx = 0; correctIdx < numGuesses.size() && numShown < 10; ++correctIdx) {
+        if (numGuesses[correctIdx] == worst) {
+            std::cout << " " << dict.m_correctWords[correctIdx];
+            ++numShown;
+        }
+    }
+    std::cout << (histogram.rbegin()->second > numShown ? " ..." : "") << std::endl;
+
+    auto numGames = numGuesses.size();
+    std::cout << "mean " << static_cast<double>(totalGuesses) / static_cast<double>(numGames) << " guesses, " << numGames
+              << " games with " << simulation.numSearches() << " searches in " << duration.count() << " s, "
+              << static_cast<double>(numGames) / duration.count() << " games/s" << std::endl;
+}
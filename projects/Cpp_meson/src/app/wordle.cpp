@@ -1,364 +1,194 @@
-#include <util/parallel/for_each.h>
-#include <wordle/AlphabetMap.h>
-#include <wordle/IsSingleWordValid.h>
+#include <wordle/Constraints.h>
+#include <wordle/Isa.h>
+#include <wordle/Server.h>
+#include <wordle/TranspositionTable.h>
 #include <wordle/Word.h>
-#include <wordle/parseDict.h>
-#include <wordle/stateFromWord.h>
+#include <wordle/WordSet.h>
+#include <wordle/parsePattern.h>
+#include <wordle/runBatch.h>
+#include <wordle/solve.h>
 
-#include <algorithm>
+#include <chrono>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
-#include <limits>
-#include <mutex>
+#include <optional>
 
-namespace wordle {
+int main(int argc, char** argv) {
+    if (argc == 1) {
+        std::cout << R"(This is a wordle solver, written to assist in https://www.powerlanguage.co.uk/wordle/
 
-/**
- * @brief Fitness score of a guess word. The lower, the better.
- */
-struct Fitness {
-    // maximum number of remaining words for each level, but in reverse.
-    std::array<size_t, 3> m_maxCounts{};
+Usage: ./wordle <prefix> [--max-depth <n>] [--time-budget-ms <ms>] [--force-isa <isa>] [--query <pattern>] [word-state]...
+       ./wordle <prefix> --batch <file> [--max-depth <n>] [--time-budget-ms <ms>]
+       ./wordle <dictionary-dir> --serve <socket> [--max-depth <n>] [--time-budget-ms <ms>]
 
-    constexpr size_t& operator[](size_t idx) {
-        return m_maxCounts[m_maxCounts.size() - idx - 1];
-    }
+Examples:
 
-    constexpr static Fitness maxi() {
-        auto f = Fitness();
-        for (auto& x : f.m_maxCounts) {
-            x = std::numeric_limits<size_t>::max();
-        }
-        return f;
-    }
-    constexpr static Fitness mini() {
-        return {};
-    }
+    ./wordle dictionaries/en
+        Loads dictionaries/en_allowed.txt and dictionaries/en_correct.txt, and calculates the best
+        starting word(s). This can take a while!
 
-private:
-    /**
-     * Don't allow default ctor, only allow static worst() and best() functions so we know what we are getting
-     */
-    Fitness() = default;
-};
-
-std::ostream& operator<<(std::ostream& os, Fitness const& f) {
-    auto prefix = std::string_view("(");
-    std::for_each(f.m_maxCounts.rbegin(), f.m_maxCounts.rend(), [&](auto const& x) {
-        os << prefix << x;
-        prefix = ", ";
-    });
-    return os << ")";
-}
+    ./wordle dictionaries/en weary00102 yelps10000
+        Loads english dictionaries, and give two guesses. Each guess consists of the word followed by
+        the state for each letter, based on the color output of https://www.powerlanguage.co.uk/wordle/.
 
-constexpr bool operator<=(Fitness const& a, Fitness const& b) {
-    return a.m_maxCounts <= b.m_maxCounts;
-}
-constexpr bool operator<(Fitness const& a, Fitness const& b) {
-    return a.m_maxCounts < b.m_maxCounts;
-}
-constexpr bool operator>=(Fitness const& a, Fitness const& b) {
-    return a.m_maxCounts >= b.m_maxCounts;
-}
-constexpr bool operator>(Fitness const& a, Fitness const& b) {
-    return a.m_maxCounts > b.m_maxCounts;
-}
-constexpr bool operator==(Fitness const& a, Fitness const& b) {
-    return a.m_maxCounts == b.m_maxCounts;
-}
-constexpr bool operator!=(Fitness const& a, Fitness const& b) {
-    return a.m_maxCounts != b.m_maxCounts;
-}
+        0: letter does not exist (e.g. 'w', 'e', 'r' for weary00102)
+        1: letter exists but wrong position (e.g. 'a' for weary00102)
+        2: letter is in correct spot (e.g. 'y' for weary00102)
 
-struct Result {
-    Fitness m_fitness = Fitness::maxi();
-    Word m_guessWord{};
+        Based on that input wordle gives the best word(s) to follow up, so the number of possibilities
+        are reduced as much as possible.
 
-    static Result maxi() {
-        return {Fitness::maxi(), Word{}};
-    }
+    ./wordle dictionaries/en.wdb weary00102
+        Loads the words from a database created by wordle-pack. That doesn't need any parsing or
+        sorting, so it starts faster. The server uses <name>.wdb automatically when it exists.
 
-    static Result mini() {
-        return {Fitness::mini(), Word{}};
-    }
-};
-
-enum class Player : bool { maxi, mini };
-
-namespace alphabeta {
-
-// see https://en.wikipedia.org/wiki/Alpha%E2%80%93beta_pruning#Pseudocode
-
-Result maxi(std::vector<Word> const& allowedWordsToEnter,
-            std::vector<Word> const& remainingCorrectWords,
-            Word const& guessWord,
-            size_t currentDepth,
-            size_t maxDepth,
-            Fitness alpha,
-            Fitness beta);
-
-Result mini(std::vector<Word> const& allowedWordsToEnter,
-            std::vector<Word> const& remainingCorrectWords,
-            size_t currentDepth,
-            size_t maxDepth,
-            Fitness alpha,
-            Fitness beta);
-
-// mini: wants to make a guess that lowers the number of remaining correct words as much as possible
-Result mini(std::vector<Word> const& allowedWordsToEnter,
-            std::vector<Word> const& remainingCorrectWords,
-            size_t currentDepth,
-            size_t maxDepth,
-            Fitness alpha,
-            Fitness beta) {
-    if (remainingCorrectWords.size() == 1) {
-        return Result{Fitness{0, currentDepth}, remainingCorrectWords.front()};
-    }
+    ./wordle embedded:en weary00102
+        Uses the english dictionary that is compiled into the binary, without accessing any files.
+        Needs a build with "meson setup -Dembed_dictionaries=true", which embeds en, de and at.
 
-    auto bestValue = Result::maxi();
+    ./wordle dictionaries/en --max-depth 3 --time-budget-ms 10000
+        Searches with depth 1, 2, 3 (default is 2, at most 4), but stops after 10 seconds. The result
+        of the deepest search that has finished is shown.
 
-    if (currentDepth == 0) {
-        // depth 0: run loop in parallel
-        auto mutex = std::mutex();
-        ankerl::parallel::for_each(allowedWordsToEnter.begin(), allowedWordsToEnter.end(), [&](Word const& guessWord) {
-            auto value = maxi(allowedWordsToEnter, remainingCorrectWords, guessWord, currentDepth, maxDepth, alpha, beta);
+    ./wordle dictionaries/en --force-isa scalar
+        Uses the given instruction set (scalar, sse4.2, avx2, avx512) for the vectorized kernels
+        instead of the best one this CPU supports. Useful for benchmarking.
 
-            auto lock = std::lock_guard(mutex);
+    ./wordle dictionaries/en --query "?a??e +r -st" pious00000
+        Lists all allowed words that match the pattern and the clues, without searching for a guess.
+        '?a??e': 'a' and 'e' at these positions, '+r': contains 'r', '-st': neither 's' nor 't'.
 
-            if (value.m_fitness < bestValue.m_fitness) {
-                bestValue.m_fitness = value.m_fitness;
-                bestValue.m_guessWord = guessWord;
+    ./wordle dictionaries/en --batch games.txt
+        Each line of games.txt (or stdin for '-') is a list of clues, e.g. "weary00102 yelps10000".
+        Prints one line "<fitness> <guess>" for each, in the same order. Lines that leave the same
+        correct words are solved only once, and different ones are solved in parallel. A line
+        "query <pattern> [word-state]..." is answered with the number of matching allowed words and
+        the words, like --query.
 
-                std::cout << currentDepth << ": \"" << guessWord << "\" alpha=" << alpha << ", beta=" << beta
-                          << ", fitness=" << value.m_fitness << std::endl;
-            }
+    ./wordle dictionaries --serve /tmp/wordle.sock --time-budget-ms 1000
+        Keeps running and answers requests on the Unix socket, one per line, e.g. "en weary00102 yelps10000".
+        Each dictionary is loaded once on first use. The answer is one line "<fitness> <guess>", or
+        "error: <message>". "en query ?a??e +r -st" lists the matching words like in batch mode.
+        See wordle-load for a client that measures the latency.
 
-            if (bestValue.m_fitness <= alpha) {
-                // alpha cutoff, stop iterating
-                return ankerl::parallel::Continue::no;
-            }
-            beta = std::min(beta, bestValue.m_fitness);
-            // continue iterating
-            return ankerl::parallel::Continue::yes;
-        } /*, 1*/);
-    } else {
-        for (Word const& guessWord : allowedWordsToEnter) {
-            auto value = maxi(allowedWordsToEnter, remainingCorrectWords, guessWord, currentDepth, maxDepth, alpha, beta);
-
-            if (value.m_fitness < bestValue.m_fitness) {
-                bestValue.m_fitness = value.m_fitness;
-                bestValue.m_guessWord = guessWord;
-            }
+by Martin Leitner-Ankerl 2022
+)";
 
-            if (bestValue.m_fitness <= alpha) {
-                // alpha cutoff, stop iterating
-                break;
-            }
-            beta = std::min(beta, bestValue.m_fitness);
-        }
+        exit(1);
     }
+    auto startTime = std::chrono::steady_clock::now();
 
-    return bestValue;
-}
+    // read & filter dictionary
+    auto prefix = std::string(argv[1]);
 
-// maxi: wants to find the most hard to guess "correct" word
-Result maxi(std::vector<Word> const& allowedWordsToEnter,
-            std::vector<Word> const& remainingCorrectWords,
-            Word const& guessWord,
-            size_t currentDepth,
-            size_t maxDepth,
-            Fitness alpha,
-            Fitness beta) {
-    Result bestValue = Result::mini();
-    for (Word const& correctWord : remainingCorrectWords) {
-        // create information for the next node
-        auto state = stateFromWord(correctWord, guessWord);
-        auto isWordValid = IsSingleWordValid(guessWord, state);
-
-        // create a new list of remaining correct words
-        auto value = Result();
-
-        if (currentDepth == maxDepth - 1) {
-            // we've reached the end, just calculate number of remaining words as the fitness value.
-            value.m_fitness[currentDepth] = 0;
-
-            for (Word const& word : remainingCorrectWords) {
-                if (isWordValid(word) && guessWord != word) {
-                    ++value.m_fitness[currentDepth];
-                }
+    auto maxDepth = size_t(2);
+    auto timeBudget = std::optional<std::chrono::milliseconds>();
+    auto clues = std::vector<std::pair<wordle::Word, wordle::State>>();
+    auto query = std::optional<std::string_view>();
+    auto socketPath = std::optional<std::string>();
+    auto batchFile = std::optional<std::string>();
+    for (int i = 2; i < argc; ++i) {
+        auto arg = std::string_view(argv[i]);
+        if (arg == "--force-isa") {
+            if (i + 1 == argc) {
+                throw std::runtime_error(std::string(arg) + " needs a value");
             }
-        } else {
-            // we have to go deeper
-            auto filteredWords = std::vector<Word>();
-            for (Word const& word : remainingCorrectWords) {
-                if (isWordValid(word) && guessWord != word) {
-                    filteredWords.push_back(word);
-                }
+            wordle::forceIsa(wordle::parseIsa(argv[++i]));
+        } else if (arg == "--query") {
+            if (i + 1 == argc) {
+                throw std::runtime_error(std::string(arg) + " needs a value");
             }
-            value = mini(allowedWordsToEnter, filteredWords, currentDepth + 1, maxDepth, alpha, beta);
-            value.m_fitness[currentDepth] = filteredWords.size();
-        }
-
-        if (value.m_fitness > bestValue.m_fitness) {
-            bestValue = value;
-
-            if (bestValue.m_fitness >= beta) {
-                // beta cutoff, stop iterating
-                break;
+            query = argv[++i];
+        } else if (arg == "--serve") {
+            if (i + 1 == argc) {
+                throw std::runtime_error(std::string(arg) + " needs a value");
             }
-            alpha = std::max(alpha, bestValue.m_fitness);
+            socketPath = argv[++i];
+        } else if (arg == "--batch") {
+            if (i + 1 == argc) {
+                throw std::runtime_error(std::string(arg) + " needs a value");
+            }
+            batchFile = argv[++i];
+        } else if (arg == "--max-depth" || arg == "--time-budget-ms") {
+            if (i + 1 == argc) {
+                throw std::runtime_error(std::string(arg) + " needs a value");
+            }
+            auto value = std::stoul(argv[++i]);
+            if (arg == "--max-depth") {
+                maxDepth = value;
+            } else {
+                timeBudget = std::chrono::milliseconds(value);
+            }
+        } else {
+            clues.push_back(wordle::parseWordAndState(arg));
         }
     }
-    return bestValue;
-}
-
-} // namespace alphabeta
-
-std::pair<Word, State> parseWordAndState(std::string_view wordAndState) {
-    if (wordAndState.size() != NumCharacters * 2) {
-        throw std::runtime_error("incorrect number of letters");
+    if (maxDepth == 0 || maxDepth > wordle::Fitness::MaxDepth) {
+        throw std::runtime_error("--max-depth must be between 1 and " + std::to_string(wordle::Fitness::MaxDepth));
     }
 
-    auto word = Word();
-    auto state = State();
-    for (size_t i = 0; i < NumCharacters; ++i) {
-        word[i] = wordAndState[i] - 'a';
-        switch (wordAndState[i + NumCharacters]) {
-        case '0':
-            state[i] = St::not_included;
-            break;
-        case '1':
-            state[i] = St::wrong_spot;
-            break;
-        case '2':
-            state[i] = St::correct;
-            break;
-        default:
-            throw std::runtime_error("invalid state character");
-        }
-    }
-    return std::make_pair(word, state);
-}
+    // batch answers go to stdout, everything else to stderr
+    (batchFile ? std::cerr : std::cout) << "instruction set: " << wordle::activeIsa() << std::endl;
 
-/**
- * @brief Reads & filters a dictionary file with newline separated words.
- *
- * Words are separated by '\n'. All are lowercase, exactly numCharacters long, sorted, and unique. No special characters.
- * Read in any dictionary file. This lowercases all words, and filters all out that don't have 5 characters or any special
- * character.
- *
- * @param filename Dictionary filename
- * @return std::string One string with all lowercase concatenated words (without any separator).
- */
-std::vector<Word> readAndFilterDictionary(std::filesystem::path filename) {
-    auto fin = std::ifstream(filename);
-    if (!fin.is_open()) {
-        throw std::runtime_error("Could not open " + filename.string());
+    if (socketPath) {
+        // prefix is the directory with the dictionaries, each request names the one it wants
+        auto server = wordle::Server(prefix, maxDepth, timeBudget);
+        server.run(*socketPath);
     }
-    return parseDict(fin);
-}
 
-// Calculates a score for each word, based on letter frequency
-void heuristicSort(std::vector<Word>& words) {
-    auto letterFrequency = AlphabetMap<size_t>();
-    for (auto const& word : words) {
-        for (auto ch : word) {
-            ++letterFrequency[ch];
-        }
-    }
+    auto dict = wordle::loadDictionary(prefix);
 
-    auto scores = std::vector<std::pair<Word, size_t>>();
-    for (auto const& word : words) {
-        auto hasLetter = AlphabetMap<bool>();
-        auto score = size_t();
-        for (auto ch : word) {
-            if (!hasLetter[ch]) {
-                score += letterFrequency[ch];
-                hasLetter[ch] = true;
+    if (batchFile) {
+        auto batchStartTime = std::chrono::steady_clock::now();
+        auto stats = wordle::BatchStats();
+        if (*batchFile == "-") {
+            stats = wordle::runBatch(dict, std::cin, std::cout, maxDepth, timeBudget);
+        } else {
+            auto fin = std::ifstream(*batchFile);
+            if (!fin.is_open()) {
+                throw std::runtime_error("Could not open " + *batchFile);
             }
+            stats = wordle::runBatch(dict, fin, std::cout, maxDepth, timeBudget);
         }
-        scores.emplace_back(word, score);
+        auto duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - batchStartTime);
+        std::cerr << stats.m_numLines << " lines, " << stats.m_numUnique << " unique, " << duration.count() << " s, "
+                  << static_cast<double>(stats.m_numLines) / duration.count() << " queries/s" << std::endl;
+        return 0;
     }
 
-    std::sort(scores.begin(), scores.end(), [](auto const& a, auto const& b) {
-        return a.second < b.second;
-    });
-
-    for (size_t i = 0; i < scores.size(); ++i) {
-        words[i] = scores[i].first;
+    // Each clue leaves exactly the correct words that would have produced the same state. All clues are merged into one
+    // constraint, so each correct word is checked just once.
+    auto constraints = query ? wordle::parsePattern(*query) : wordle::Constraints();
+    for (auto const& [word, state] : clues) {
+        constraints.add(word, state);
     }
-}
-
-} // namespace wordle
 
-int main(int argc, char** argv) {
-    if (argc == 1) {
-        std::cout << R"(This is a wordle solver, written to assist in https://www.powerlanguage.co.uk/wordle/
-
-Usage: ./wordle <prefix> [word-state]...
-
-Examples:
-
-    ./wordle dictionaries/en
-        Loads dictionaries/en_allowed.txt and dictionaries/en_correct.txt, and calculates the best
-        starting word(s). This can take a while!
-
-    ./wordle dictionaries/en weary00102 yelps10000
-        Loads english dictionaries, and give two guesses. Each guess consists of the word followed by
-        the state for each letter, based on the color output of https://www.powerlanguage.co.uk/wordle/.
-
-        0: letter does not exist (e.g. 'w', 'e', 'r' for weary00102)
-        1: letter exists but wrong position (e.g. 'a' for weary00102)
-        2: letter is in correct spot (e.g. 'y' for weary00102)
-
-        Based on that input wordle gives the best word(s) to follow up, so the number of possibilities
-        are reduced as much as possible.
-
-by Martin Leitner-Ankerl 2022
-)";
-
-        exit(1);
-    }
-    // read & filter dictionary
-    auto prefix = std::string(argv[1]);
-
-    auto allowedWords = wordle::readAndFilterDictionary(prefix + "_allowed.txt");
-    auto wordsCorrect = wordle::readAndFilterDictionary(prefix + "_correct.txt");
-
-    wordle::heuristicSort(allowedWords);
-    wordle::heuristicSort(wordsCorrect);
-    std::reverse(allowedWords.begin(), allowedWords.end());
-
-    auto validators = std::vector<wordle::IsSingleWordValid>();
-    for (int i = 2; i < argc; ++i) {
-        auto [word, state] = wordle::parseWordAndState(argv[i]);
-        validators.emplace_back(word, state);
+    if (query) {
+        auto indices = dict.m_allowedIndex.query(constraints);
+        for (auto idx : indices) {
+            std::cout << dict.m_allowedWords[idx] << " ";
+        }
+        std::cout << std::endl << indices.size() << " words" << std::endl;
+        return 0;
     }
+    auto filteredCorrectWords = wordle::filterCorrectWords(dict, constraints);
 
     // pre.debugPrint();
 
-    // create list of words that are currently valid
-    auto filteredCorrectWords = std::vector<wordle::Word>();
-    for (auto word : wordsCorrect) {
-        auto it = std::find_if_not(validators.begin(), validators.end(), [&](auto const& validator) {
-            return validator(word);
-        });
-        if (it == validators.end()) {
-            filteredCorrectWords.push_back(word);
-            std::cout << word << " ";
-        }
-    }
+    filteredCorrectWords.forEach([&](size_t correctIdx) {
+        std::cout << dict.m_correctWords[correctIdx] << " ";
+    });
     std::cout << std::endl;
 
-    auto alpha = wordle::Fitness::mini();
-    auto beta = wordle::Fitness::maxi();
-    size_t currentDepth = 0;
-    size_t maxDepth = 2;
-
-    auto bestResult = wordle::alphabeta::mini(allowedWords, filteredCorrectWords, currentDepth, maxDepth, alpha, beta);
+    auto deadline = std::optional<std::chrono::steady_clock::time_point>();
+    if (timeBudget) {
+        deadline = startTime + *timeBudget;
+    }
+    auto transpositions = wordle::TranspositionTable<wordle::Result>(1U << 18U);
+    auto bestResult = wordle::solve(dict, filteredCorrectWords, transpositions, maxDepth, deadline, true, true);
 
-    std::cout << bestResult.m_fitness << " " << bestResult.m_guessWord << std::endl;
+    std::cout << bestResult.m_fitness << " " << dict.word(bestResult.m_guessId) << std::endl;
 }
 
 /**
@@ -369,7 +199,7 @@ namespace wordle::test {
 constexpr Word toStateWord(std::string_view str) {
     Word w{};
     for (size_t i = 0; i < str.size(); ++i) {
-        w[i] = str[i];
+        w.set(i, str[i]);
     }
     return w;
 }
@@ -0,0 +1,95 @@
+#include "Bench.h"
+
+#include <wordle/Isa.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+namespace bench {
+
+namespace {
+
+double medianOf(std::vector<double> values) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    auto mid = values.begin() + static_cast<std::ptrdiff_t>(values.size() / 2);
+    std::nth_element(values.begin(), mid, values.end());
+    if (values.size() % 2 == 1) {
+        return *mid;
+    }
+    return (*mid + *std::max_element(values.begin(), mid)) / 2;
+}
+
+// names are plain ASCII, only quotes and backslashes need escaping
+std::string jsonString(std::string const& str) {
+    auto escaped = std::string("\"");
+    for (auto ch : str) {
+        if (ch == '"' || ch == '\\') {
+            escaped += '\\';
+        }
+        escaped += ch;
+    }
+    return escaped + '"';
+}
+
+} // namespace
+
+double Result::median() const {
+    return medianOf(m_secondsPerOp);
+}
+
+double Result::mad() const {
+    auto med = median();
+    auto deviations = std::vector<double>();
+    for (auto s : m_secondsPerOp) {
+        deviations.push_back(std::abs(s - med));
+    }
+    return medianOf(deviations);
+}
+
+Bench::Bench(std::string filter, size_t numEpochs, std::chrono::nanoseconds minEpochTime, bool isSlowIncluded)
+    : m_filter(std::move(filter))
+    , m_numEpochs(numEpochs)
+    , m_minEpochTime(minEpochTime)
+    , m_isSlowIncluded(isSlowIncluded) {
+    std::cout << "|              ns/op |  MAD % |          op/s | benchmark" << std::endl;
+    std::cout << "|-------------------:|-------:|--------------:|:----------" << std::endl;
+}
+
+bool Bench::isSelected(std::string const& name) const {
+    return name.find(m_filter) != std::string::npos;
+}
+
+void Bench::add(Result result) {
+    auto median = result.median();
+    std::cout << "| " << std::setw(18) << std::fixed << std::setprecision(2) << median * 1e9 << " | " << std::setw(6)
+              << (median > 0 ? 100 * result.mad() / median : 0.0) << " | " << std::setw(13) << std::setprecision(1)
+              << (median > 0 ? 1.0 / median : 0.0) << " | " << result.m_name << std::endl;
+    m_results.push_back(std::move(result));
+}
+
+void Bench::writeJson(std::ostream& os) const {
+    os << std::setprecision(9) << "{\n  \"isa\": " << jsonString(std::string(wordle::isaName(wordle::activeIsa())))
+       << ",\n  \"compiler\": " << jsonString(__VERSION__) << ",\n  \"benchmarks\": [";
+    auto separator = "\n";
+    for (auto const& result : m_results) {
+        auto median = result.median();
+        os << separator << "    {\"name\": " << jsonString(result.m_name) << ", \"ops_per_run\": " << result.m_opsPerRun
+           << ", \"runs_per_epoch\": " << result.m_runsPerEpoch << ", \"median_ns_per_op\": " << median * 1e9
+           << ", \"mad_ns_per_op\": " << result.mad() * 1e9
+           << ", \"ops_per_second\": " << (median > 0 ? 1.0 / median : 0.0) << ", \"ns_per_op\": [";
+        auto valueSeparator = "";
+        for (auto s : result.m_secondsPerOp) {
+            os << valueSeparator << s * 1e9;
+            valueSeparator = ", ";
+        }
+        os << "]}";
+        separator = ",\n";
+    }
+    os << "\n  ]\n}\n";
+}
+
+} // namespace bench
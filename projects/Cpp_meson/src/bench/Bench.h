@@ -0,0 +1,122 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+/**
+ * @brief Keeps the compiler from optimizing away the calculation of value.
+ */
+template <typename T>
+void doNotOptimizeAway(T const& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/**
+ * @brief Measurements of one benchmark. Each epoch runs the operation a number of times, and gives one time per op.
+ */
+struct Result {
+    std::string m_name;
+    size_t m_opsPerRun{};
+    size_t m_runsPerEpoch{};
+    std::vector<double> m_secondsPerOp{};
+
+    double median() const;
+
+    // median absolute deviation, robust against the outliers a busy machine produces
+    double mad() const;
+};
+
+/**
+ * @brief Minimal benchmark runner: warms up, repeats each benchmark for some epochs and prints median, MAD and ops/s.
+ */
+class Bench {
+    std::string m_filter;
+    size_t m_numEpochs;
+    std::chrono::nanoseconds m_minEpochTime;
+    bool m_isSlowIncluded;
+    std::vector<Result> m_results{};
+
+    bool isSelected(std::string const& name) const;
+    void add(Result result);
+
+public:
+    Bench(std::string filter, size_t numEpochs, std::chrono::nanoseconds minEpochTime, bool isSlowIncluded);
+
+    /**
+     * @brief True when benchmarks that take minutes should run too.
+     */
+    bool isSlowIncluded() const {
+        return m_isSlowIncluded;
+    }
+
+    /**
+     * @brief Measures op, which does numOps operations per call. Skipped when the name doesn't contain the filter.
+     *
+     * The first call is the warmup. Fast ops are called repeatedly in each epoch, so an epoch takes at least minEpochTime.
+     * Ops that take longer than a second are only measured for 3 epochs.
+     */
+    template <typename Op>
+    Bench& run(std::string const& name, size_t numOps, Op&& op) {
+        if (!isSelected(name)) {
+            return *this;
+        }
+
+        using Clock = std::chrono::steady_clock;
+        auto before = Clock::now();
+        op();
+        auto warmupTime = Clock::now() - before;
+
+        auto result = Result{name, numOps, 1, {}};
+        while (warmupTime * result.m_runsPerEpoch < m_minEpochTime) {
+            result.m_runsPerEpoch *= 2;
+        }
+        auto numEpochs = warmupTime > std::chrono::seconds(1) ? std::min<size_t>(m_numEpochs, 3) : m_numEpochs;
+        for (size_t epoch = 0; epoch < numEpochs; ++epoch) {
+            before = Clock::now();
+            for (size_t i = 0; i < result.m_runsPerEpoch; ++i) {
+                op();
+            }
+            auto seconds = std::chrono::duration<double>(Clock::now() - before).count();
+            result.m_secondsPerOp.push_back(seconds / static_cast<double>(result.m_runsPerEpoch * numOps));
+        }
+        add(std::move(result));
+        return *this;
+    }
+
+    /**
+     * @brief Measures a single call of op, without warmup. For ops that take many seconds, where repeating them would make
+     * the whole run too slow.
+     */
+    template <typename Op>
+    Bench& runOnce(std::string const& name, size_t numOps, Op&& op) {
+        if (!isSelected(name)) {
+            return *this;
+        }
+
+        using Clock = std::chrono::steady_clock;
+        auto before = Clock::now();
+        op();
+        auto seconds = std::chrono::duration<double>(Clock::now() - before).count();
+        add(Result{name, numOps, 1, {seconds / static_cast<double>(numOps)}});
+        return *this;
+    }
+
+    std::vector<Result> const& results() const {
+        return m_results;
+    }
+
+    /**
+     * @brief All results as JSON, including the raw time per op of each epoch.
+     */
+    void writeJson(std::ostream& os) const;
+};
+
+void benchKernels(Bench& bench);
+void benchSearch(Bench& bench);
+
+} // namespace bench
@@ -0,0 +1,133 @@
+#include "Bench.h"
+
+#include <util/parallel/for_each.h>
+#include <wordle/Constraints.h>
+#include <wordle/IsSingleWordValid.h>
+#include <wordle/Isa.h>
+#include <wordle/WordColumns.h>
+#include <wordle/WordIndex.h>
+#include <wordle/parseDict.h>
+#include <wordle/solve.h>
+#include <wordle/stateFromWord.h>
+#include <wordle/statesFromWord.h>
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+namespace {
+
+std::string readFile(std::string const& filename) {
+    auto fin = std::ifstream(filename);
+    auto ss = std::stringstream();
+    ss << fin.rdbuf();
+    return ss.str();
+}
+
+} // namespace
+
+void benchKernels(Bench& bench) {
+    auto allowedText = readFile(WORDLE_DATA_DIR "/data/en_allowed.txt");
+    auto allowedWords = wordle::parseDict(allowedText);
+    auto correctWords = wordle::readAndFilterDictionary(WORDLE_DATA_DIR "/data/en_correct.txt");
+
+    // the first 100 allowed words against all correct words, for all feedback kernels
+    auto guessWords = std::vector<wordle::Word>(allowedWords.begin(), allowedWords.begin() + 100);
+    auto numPairs = guessWords.size() * correctWords.size();
+
+    bench.run("stateFromWord", numPairs, [&] {
+        auto sum = size_t();
+        for (auto const& guess : guessWords) {
+            for (auto const& correct : correctWords) {
+                sum += wordle::toStateCode(wordle::stateFromWord(correct, guess));
+            }
+        }
+        doNotOptimizeAway(sum);
+    });
+
+    auto correctColumns = wordle::WordColumns(correctWords);
+    auto codes = std::vector<uint8_t>(correctWords.size());
+    auto previousIsa = wordle::activeIsa();
+    for (auto isa : {wordle::Isa::scalar, wordle::Isa::sse42, wordle::Isa::avx2, wordle::Isa::avx512}) {
+        if (!wordle::isSupported(isa)) {
+            continue;
+        }
+        wordle::forceIsa(isa);
+        bench.run("statesFromWord " + std::string(wordle::isaName(isa)), numPairs, [&] {
+            for (auto const& guess : guessWords) {
+                wordle::statesFromWord(guess, correctColumns.columnPointers(), correctWords.size(), codes.data());
+                doNotOptimizeAway(codes.front());
+            }
+        });
+    }
+    wordle::forceIsa(previousIsa);
+
+    // a typical first clue, which most words fail
+    auto clueWord = wordle::Word();
+    for (size_t i = 0; i < wordle::NumCharacters; ++i) {
+        clueWord.set(i, "raise"[i] - 'a');
+    }
+    auto clueState = wordle::stateFromWord(correctWords[100], clueWord);
+
+    auto validator = wordle::IsSingleWordValid(clueWord, clueState);
+    bench.run("IsSingleWordValid", allowedWords.size(), [&] {
+        auto numValid = size_t();
+        for (auto const& word : allowedWords) {
+            numValid += validator(word) ? 1 : 0;
+        }
+        doNotOptimizeAway(numValid);
+    });
+
+    auto constraints = wordle::Constraints();
+    constraints.add(clueWord, clueState);
+    bench.run("Constraints", allowedWords.size(), [&] {
+        auto numValid = size_t();
+        for (auto const& word : allowedWords) {
+            numValid += constraints(word) ? 1 : 0;
+        }
+        doNotOptimizeAway(numValid);
+    });
+
+    auto allowedColumns = wordle::WordColumns(allowedWords);
+    bench.run("WordColumns::filter", allowedWords.size(), [&] {
+        doNotOptimizeAway(allowedColumns.filter(constraints).size());
+    });
+
+    auto index = wordle::WordIndex(allowedWords);
+    bench.run("WordIndex::query", allowedWords.size(), [&] {
+        doNotOptimizeAway(index.query(constraints).size());
+    });
+
+    bench.run("parseDict en_allowed", allowedWords.size(), [&] {
+        doNotOptimizeAway(wordle::parseDict(allowedText).size());
+    });
+
+    bench.run("parseDictFile en_allowed", allowedWords.size(), [&] {
+        doNotOptimizeAway(wordle::parseDictFile(WORDLE_DATA_DIR "/data/en_allowed.txt").size());
+    });
+
+    bench.run("heuristicSort en_allowed", allowedWords.size(), [&] {
+        auto words = allowedWords;
+        wordle::heuristicSort(words);
+        doNotOptimizeAway(words.front());
+    });
+
+    // overhead per item of the parallel loop, with items that do almost nothing
+    auto items = std::vector<size_t>(100'000);
+    std::iota(items.begin(), items.end(), size_t());
+    bench.run("for_each empty items", items.size(), [&] {
+        auto sum = std::atomic<size_t>();
+        ankerl::parallel::for_each(items.begin(), items.end(), [&](size_t item) {
+            sum.fetch_add(item, std::memory_order_relaxed);
+        });
+        doNotOptimizeAway(sum.load());
+    });
+}
+
+} // namespace bench
@@ -0,0 +1,64 @@
+#include "Bench.h"
+
+#include <wordle/Isa.h>
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+int main(int argc, char** argv) {
+    auto filter = std::string();
+    auto jsonFile = std::string();
+    auto numEpochs = size_t(11);
+    auto isSlowIncluded = false;
+    for (int i = 1; i < argc; ++i) {
+        auto arg = std::string_view(argv[i]);
+        if (arg == "-h" || arg == "--help") {
+            std::cout << R"(Benchmarks of the wordle kernels and searches
+
+Usage: ./bench-wordle [--filter <text>] [--epochs <n>] [--json <file>] [--force-isa <isa>] [--slow]
+
+    --filter <text>   only runs benchmarks whose name contains text, e.g. "statesFromWord" or "opener en"
+    --epochs <n>      number of measurements of each benchmark (default 11), slow ones use at most 3
+    --json <file>     also writes all results to file, to compare builds
+    --force-isa <isa> uses this instruction set for the vectorized kernels, like ./wordle
+    --slow            also runs the benchmarks that take minutes, e.g. "opener en depth 2"
+)";
+            return 0;
+        }
+        if (arg == "--slow") {
+            isSlowIncluded = true;
+            continue;
+        }
+        if (i + 1 == argc) {
+            throw std::runtime_error(std::string(arg) + " needs a value");
+        }
+        if (arg == "--filter") {
+            filter = argv[++i];
+        } else if (arg == "--epochs") {
+            numEpochs = std::stoul(argv[++i]);
+        } else if (arg == "--json") {
+            jsonFile = argv[++i];
+        } else if (arg == "--force-isa") {
+            wordle::forceIsa(wordle::parseIsa(argv[++i]));
+        } else {
+            throw std::runtime_error("unknown argument " + std::string(arg));
+        }
+    }
+
+    std::cout << "instruction set: " << wordle::activeIsa() << std::endl;
+    auto bench = bench::Bench(filter, numEpochs, std::chrono::milliseconds(20), isSlowIncluded);
+    bench::benchKernels(bench);
+    bench::benchSearch(bench);
+
+    if (!jsonFile.empty()) {
+        auto fout = std::ofstream(jsonFile);
+        if (!fout.is_open()) {
+            throw std::runtime_error("Could not open " + jsonFile);
+        }
+        bench.writeJson(fout);
+    }
+}
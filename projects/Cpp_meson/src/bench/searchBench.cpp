@@ -0,0 +1,61 @@
+#include "Bench.h"
+
+#include <wordle/solve.h>
+#include <wordle/stateFromWord.h>
+
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace bench {
+
+void benchSearch(Bench& bench) {
+    auto transpositions = wordle::TranspositionTable<wordle::Result>(1U << 18U);
+
+    for (auto name : {"en", "de", "at"}) {
+        auto dict = wordle::loadDictionary(std::string(WORDLE_DATA_DIR "/data/") + name);
+        auto const& correctWords = dict.m_correctWords;
+
+        auto allCorrectWords = wordle::WordSet();
+        for (size_t correctIdx = 0; correctIdx < correctWords.size(); ++correctIdx) {
+            allCorrectWords.insert(correctIdx);
+        }
+        auto solveOpener = [&](size_t depth) {
+            auto result = wordle::solve(dict, allCorrectWords, transpositions, depth, std::nullopt, false, true);
+            doNotOptimizeAway(result.m_guessId);
+        };
+        bench.run(std::string("opener ") + name + " depth 1", 1, [&] {
+            solveOpener(1);
+        });
+
+        // Takes seconds, for english even minutes. So it's measured only once, and english only with --slow.
+        if (std::string_view(name) != "en" || bench.isSlowIncluded()) {
+            bench.runOnce(std::string("opener ") + name + " depth 2", 1, [&] {
+                solveOpener(2);
+            });
+        }
+
+        // Mid-game: the first one or two heuristically best guesses, against a few correct words spread over the
+        // dictionary. The clues come from stateFromWord(), so they are realistic for any dictionary.
+        for (auto correctIdx : {correctWords.size() / 4, correctWords.size() / 2, correctWords.size() * 3 / 4}) {
+            auto const& correctWord = correctWords[correctIdx];
+            auto constraints = wordle::Constraints();
+            for (size_t numGuesses = 1; numGuesses <= 2; ++numGuesses) {
+                auto const& guess = dict.m_allowedWords[numGuesses - 1];
+                constraints.add(guess, wordle::stateFromWord(correctWord, guess));
+                auto remainingCorrectWords = wordle::filterCorrectWords(dict, constraints);
+
+                auto os = std::ostringstream();
+                os << "midgame " << name << " " << correctWord << " after " << numGuesses << " guesses ("
+                   << remainingCorrectWords.size() << " words) depth 2";
+                bench.run(os.str(), 1, [&] {
+                    auto result = wordle::solve(dict, remainingCorrectWords, transpositions, 2, std::nullopt, false, true);
+                    doNotOptimizeAway(result.m_guessId);
+                });
+            }
+        }
+    }
+}
+
+} // namespace bench
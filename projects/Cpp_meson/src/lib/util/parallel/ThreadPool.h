@@ -0,0 +1,259 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Persistent work stealing thread pool with fork/join task groups.
+//
+// Each worker owns a deque. Tasks forked by a worker are pushed to the back of its own deque, and the worker pops from the
+// back too (so it works depth first on what it just created). Idle workers steal from the front of other deques, which is
+// where the oldest and usually largest tasks are.
+//
+// Waiting for a TaskGroup never blocks a worker: while tasks of the group are still running, the waiting thread executes
+// other tasks. So task groups can be nested arbitrarily deep, e.g. a parallel loop inside a parallel loop.
+
+namespace ankerl::parallel {
+
+class ThreadPool {
+    using Task = std::function<void()>;
+
+    struct Queue {
+        std::mutex m_mutex{};
+        std::deque<Task> m_tasks{};
+    };
+
+    // queue 0 is used by all threads that are not part of the pool, queue i by worker i.
+    std::vector<std::unique_ptr<Queue>> m_queues{};
+    std::vector<std::thread> m_workers{};
+
+    std::atomic<size_t> m_numQueuedTasks{};
+    std::atomic<bool> m_isStopping{};
+    std::mutex m_sleepMutex{};
+    std::condition_variable m_sleepCondition{};
+
+    struct ThreadInfo {
+        ThreadPool const* m_pool = nullptr;
+        size_t m_queueIdx = 0;
+    };
+
+    static ThreadInfo& threadInfo() {
+        static thread_local auto info = ThreadInfo();
+        return info;
+    }
+
+    size_t myQueueIdx() const {
+        auto const& info = threadInfo();
+        if (info.m_pool == this) {
+            return info.m_queueIdx;
+        }
+        return 0;
+    }
+
+    bool tryPop(size_t queueIdx, Task& task) {
+        auto& q = *m_queues[queueIdx];
+        auto lock = std::lock_guard(q.m_mutex);
+        if (q.m_tasks.empty()) {
+            return false;
+        }
+        task = std::move(q.m_tasks.back());
+        q.m_tasks.pop_back();
+        --m_numQueuedTasks;
+        return true;
+    }
+
+    bool trySteal(size_t queueIdx, Task& task) {
+        auto& q = *m_queues[queueIdx];
+        auto lock = std::lock_guard(q.m_mutex);
+        if (q.m_tasks.empty()) {
+            return false;
+        }
+        task = std::move(q.m_tasks.front());
+        q.m_tasks.pop_front();
+        --m_numQueuedTasks;
+        return true;
+    }
+
+    // First look at our own queue, then try to steal from all others.
+    bool tryGet(size_t queueIdx, Task& task) {
+        if (tryPop(queueIdx, task)) {
+            return true;
+        }
+        for (size_t i = 1; i < m_queues.size(); ++i) {
+            if (trySteal((queueIdx + i) % m_queues.size(), task)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void workerLoop(size_t queueIdx) {
+        threadInfo() = ThreadInfo{this, queueIdx};
+        auto task = Task();
+        while (true) {
+            if (tryGet(queueIdx, task)) {
+                task();
+                task = nullptr;
+                continue;
+            }
+
+            auto lock = std::unique_lock(m_sleepMutex);
+            m_sleepCondition.wait(lock, [&] {
+                return m_numQueuedTasks != 0 || m_isStopping;
+            });
+            if (m_isStopping) {
+                return;
+            }
+        }
+    }
+
+public:
+    /**
+     * @brief Creates a pool where numThreads threads work. The thread that waits for a TaskGroup is one of them, so only
+     * numThreads - 1 threads are started.
+     */
+    explicit ThreadPool(size_t numThreads = std::thread::hardware_concurrency()) {
+        numThreads = std::max<size_t>(numThreads, 1);
+        for (size_t i = 0; i < numThreads; ++i) {
+            m_queues.push_back(std::make_unique<Queue>());
+        }
+        for (size_t i = 1; i < numThreads; ++i) {
+            m_workers.emplace_back([this, i] {
+                workerLoop(i);
+            });
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            auto lock = std::lock_guard(m_sleepMutex);
+            m_isStopping = true;
+        }
+        m_sleepCondition.notify_all();
+        for (auto& worker : m_workers) {
+            worker.join();
+        }
+    }
+
+    ThreadPool(ThreadPool const&) = delete;
+    ThreadPool& operator=(ThreadPool const&) = delete;
+
+    /**
+     * @brief Pool that is shared by the whole process, with one thread per core.
+     */
+    static ThreadPool& global() {
+        static auto pool = ThreadPool();
+        return pool;
+    }
+
+    size_t numThreads() const {
+        return m_queues.size();
+    }
+
+    /**
+     * @brief Pushes a task to the calling thread's queue.
+     */
+    void push(Task task) {
+        {
+            auto& q = *m_queues[myQueueIdx()];
+            auto lock = std::lock_guard(q.m_mutex);
+            q.m_tasks.push_back(std::move(task));
+        }
+        {
+            // lock so a worker can't miss the wakeup between checking the counter and going to sleep
+            auto lock = std::lock_guard(m_sleepMutex);
+            ++m_numQueuedTasks;
+        }
+        m_sleepCondition.notify_one();
+    }
+
+    /**
+     * @brief Runs one queued task, if there is any.
+     *
+     * @return true if a task was run.
+     */
+    bool tryRunOne() {
+        auto task = Task();
+        if (tryGet(myQueueIdx(), task)) {
+            task();
+            return true;
+        }
+        return false;
+    }
+};
+
+/**
+ * @brief Set of tasks that can be waited for (fork/join).
+ *
+ * If a task throws, the first exception is rethrown in wait().
+ */
+class TaskGroup {
+    ThreadPool& m_pool;
+    std::atomic<size_t> m_numPending{};
+    std::mutex m_exceptionMutex{};
+    std::exception_ptr m_exception{};
+
+public:
+    explicit TaskGroup(ThreadPool& pool = ThreadPool::global())
+        : m_pool(pool) {}
+
+    TaskGroup(TaskGroup const&) = delete;
+    TaskGroup& operator=(TaskGroup const&) = delete;
+
+    ~TaskGroup() {
+        // never leave tasks behind that reference this group
+        while (m_numPending != 0) {
+            if (!m_pool.tryRunOne()) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    ThreadPool& pool() const {
+        return m_pool;
+    }
+
+    /**
+     * @brief Forks a task. It may run on any thread of the pool, including the one that calls wait().
+     */
+    template <typename Op>
+    void run(Op&& op) {
+        ++m_numPending;
+        m_pool.push([this, op = std::forward<Op>(op)]() mutable {
+            try {
+                op();
+            } catch (...) {
+                auto lock = std::lock_guard(m_exceptionMutex);
+                if (!m_exception) {
+                    m_exception = std::current_exception();
+                }
+            }
+            --m_numPending;
+        });
+    }
+
+    /**
+     * @brief Joins all forked tasks. Instead of blocking, the calling thread helps executing tasks.
+     */
+    void wait() {
+        while (m_numPending != 0) {
+            if (!m_pool.tryRunOne()) {
+                std::this_thread::yield();
+            }
+        }
+        if (m_exception) {
+            std::rethrow_exception(std::exchange(m_exception, nullptr));
+        }
+    }
+};
+
+} // namespace ankerl::parallel
@@ -1,22 +1,21 @@
 #pragma once
 
-#include <atomic>
-#include <thread>
-#include <vector>
-
-#define ANKERL_PARALLEL_FOR_EACH_DEBUG() 0
+#include <util/parallel/ThreadPool.h>
 
-#if ANKERL_PARALLEL_FOR_EACH_DEBUG()
-#    include <iostream>
-#endif
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
 
-// in contrast to std::for_each(std::execution::par, ...), this creates a thread pool that sequentially takes one job after
-// another. That means it is helpful to have larger jobs coming first.
+// in contrast to std::for_each(std::execution::par, ...), this runs on a persistent work stealing ThreadPool. The range is
+// split recursively: the calling thread works from the front, while idle threads steal the larger halves from the back. That
+// means it is helpful to have the important jobs coming first.
 //
-// This strategy helps when there are lots of slow jobs and many fast jobs.
+// Since waiting threads help with other tasks, for_each can be nested: a job can itself use for_each, and the parts it forks
+// are stolen by idle threads. So a few slow jobs don't leave the other cores idle.
 //
-// Also, it is possible to stop early, when one worker returns Continue::no. All other workers will be stopped when they have
-// finished their current job.
+// Also, it is possible to stop early, when one job returns Continue::no. All other jobs that have already started will be
+// finished, but no new ones are started.
 
 namespace ankerl::parallel {
 
@@ -24,57 +23,60 @@ enum class Continue : bool { no, yes };
 
 namespace detail {
 
-template <typename Op, typename T, typename It>
-void loop(Op&& op, std::atomic<T>& atomicIdx, T size, int workerId, It begin) {
-    for (auto myIdx = atomicIdx++; myIdx < size; myIdx = atomicIdx++) {
-#if ANKERL_PARALLEL_FOR_EACH_DEBUG()
-        std::cout << workerId << ": " << myIdx << "/" << size << std::endl;
-#else
-        (void)workerId;
-#endif
+template <typename It, typename Op>
+struct ForEachRange {
+    Op* m_op;
+    TaskGroup* m_group;
+    std::atomic<bool>* m_isStopped;
+    size_t m_grainSize;
+
+    void operator()(It begin, It end) const {
+        // fork off the back half until the remaining range is small enough
+        while (static_cast<size_t>(std::distance(begin, end)) > m_grainSize) {
+            auto mid = std::next(begin, std::distance(begin, end) / 2);
+            m_group->run([self = *this, mid, end] {
+                self(mid, end);
+            });
+            end = mid;
+        }
 
-        if constexpr (std::is_same_v<void, std::invoke_result_t<Op, decltype(*begin)>>) {
-            op(*(begin + myIdx));
-        } else {
-            Continue c = op(*(begin + myIdx));
-            if (Continue::no == c) {
-                atomicIdx = size;
+        for (; begin != end && !*m_isStopped; ++begin) {
+            if constexpr (std::is_same_v<void, std::invoke_result_t<Op, decltype(*begin)>>) {
+                (*m_op)(*begin);
+            } else {
+                Continue c = (*m_op)(*begin);
+                if (Continue::no == c) {
+                    *m_isStopped = true;
+                }
             }
         }
     }
-#if ANKERL_PARALLEL_FOR_EACH_DEBUG()
-    std::cout << workerId << " done!" << std::endl;
-#endif
-}
+};
 
 } // namespace detail
 
-// loops until all is done, or until Op returns false.
+// loops until all is done, or until Op returns Continue::no.
 template <typename It, typename Op>
-void for_each(It begin, It end, Op&& op, int numThreads) {
-    auto size = std::distance(begin, end);
-    auto numWorkers = std::min<int>(numThreads, size);
-    auto workers = std::vector<std::thread>();
-    workers.reserve(numThreads);
-
-    auto atomicIdx = std::atomic<decltype(size)>(0);
-    for (auto workerId = int(0); workerId < numWorkers - 1; ++workerId) {
-        workers.emplace_back([&atomicIdx, &begin, size, &op, workerId]() {
-            detail::loop(op, atomicIdx, size, workerId + 1, begin);
-        });
+void for_each(It begin, It end, Op&& op, ThreadPool& pool) {
+    auto size = static_cast<size_t>(std::distance(begin, end));
+    if (size == 0) {
+        return;
     }
 
-    // this thread should work too!
-    detail::loop(op, atomicIdx, size, 0, begin);
+    // enough pieces so that threads can balance the load, but not so many that task overhead matters
+    auto grainSize = std::max<size_t>(1, size / (pool.numThreads() * 16));
 
-    for (auto& worker : workers) {
-        worker.join();
-    }
+    // declared before the group, so it outlives tasks that are drained when op throws
+    auto isStopped = std::atomic<bool>(false);
+    auto group = TaskGroup(pool);
+    auto range = detail::ForEachRange<It, std::remove_reference_t<Op>>{&op, &group, &isStopped, grainSize};
+    range(begin, end);
+    group.wait();
 }
 
 template <typename It, typename Op>
-void for_each(It it, It end, Op&& op) {
-    for_each(it, end, std::forward<Op>(op), std::thread::hardware_concurrency());
+void for_each(It begin, It end, Op&& op) {
+    for_each(begin, end, std::forward<Op>(op), ThreadPool::global());
 }
 
 } // namespace ankerl::parallel
@@ -0,0 +1,72 @@
+#include <wordle/solve.h>
+
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Writes the words as a constexpr array named identifier.
+void writeWords(std::ostream& out, std::string const& identifier, std::vector<wordle::Word> const& words) {
+    out << "constexpr Word " << identifier << "[] = {";
+    for (size_t i = 0; i < words.size(); ++i) {
+        out << (i % 4 == 0 ? "\n    " : " ") << "Word::fromBits(0x" << std::hex << std::setw(7) << std::setfill('0')
+            << words[i].bits() << std::dec << "),";
+    }
+    out << "\n};\n\n";
+}
+
+} // namespace
+
+// Build tool for the embed_dictionaries option: generates the source that defines embeddedDictionaries().
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "usage: wordle-embed <output.cpp> [<prefix>]..." << std::endl;
+        return 1;
+    }
+
+    auto out = std::ofstream(argv[1]);
+    out << "// Generated by wordle-embed, don't edit.\n\n";
+    out << "#include <wordle/embeddedDictionaries.h>\n\n";
+    out << "#include <iterator>\n\n";
+    out << "namespace wordle {\n\nnamespace {\n\n";
+
+    auto names = std::vector<std::string>();
+    for (int i = 2; i < argc; ++i) {
+        auto prefix = std::string(argv[i]);
+        auto name = std::filesystem::path(prefix).filename().string();
+        for (auto ch : name) {
+            if (!((ch >= 'a' && ch <= 'z') || (ch >= '0' && ch <= '9') || ch == '_')) {
+                throw std::runtime_error("dictionary name '" + name + "' is not a valid identifier");
+            }
+        }
+
+        // same order as loadDictionary() would bring them in
+        auto [allowedWords, correctWords] = wordle::readWordLists(prefix);
+        writeWords(out, name + "_allowed", allowedWords);
+        writeWords(out, name + "_correct", correctWords);
+        names.push_back(name);
+    }
+
+    out << "constexpr EmbeddedDictionary dictionaries[] = {\n";
+    for (auto const& name : names) {
+        out << "    {\"" << name << "\", " << name << "_allowed, std::size(" << name << "_allowed), " << name << "_correct, "
+            << "std::size(" << name << "_correct)},\n";
+    }
+    // a zero-sized array is not allowed
+    if (names.empty()) {
+        out << "    {\"\", nullptr, 0, nullptr, 0},\n";
+    }
+    out << "};\n\n} // namespace\n\n";
+    out << "EmbeddedDictionaries embeddedDictionaries() {\n";
+    out << "    return {dictionaries, " << names.size() << "};\n";
+    out << "}\n\n} // namespace wordle\n";
+
+    if (!out) {
+        throw std::runtime_error(std::string("Could not write ") + argv[1]);
+    }
+}
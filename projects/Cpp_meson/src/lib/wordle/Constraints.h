@@ -0,0 +1,180 @@
+#pragma once
+
+#include <wordle/AlphabetMap.h>
+#include <wordle/State.h>
+#include <wordle/Word.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace wordle {
+
+/**
+ * @brief Everything that any number of clues (guess word and state) tell about the correct word.
+ *
+ * All clues are merged into one canonical form: the letters that are allowed at each position, and how often each letter
+ * occurs at least and at most. A grey letter proves the exact count, e.g. "geese" with state "20100" means exactly one 'e'
+ * besides the green one. Checking a word is then independent of the number of clues.
+ *
+ * A word passes exactly when stateFromWord() gives the entered state for each clue.
+ */
+class Constraints {
+    // for each position, bitfield of the letters that are allowed there
+    std::array<uint32_t, NumCharacters> m_allowedLetters{};
+
+    AlphabetMap<uint8_t> m_minCounts{};
+    AlphabetMap<uint8_t> m_maxCounts{NumCharacters};
+
+    // letters with a minimum count, so operator() doesn't have to look at the whole alphabet
+    std::array<char, NumCharacters> m_requiredLetters{};
+    size_t m_numRequiredLetters{};
+
+    bool m_isSatisfiable = true;
+
+    // The required letters must fit into a word. Once unsatisfiable, the constraints stay that way.
+    constexpr void updateRequiredLetters() {
+        m_numRequiredLetters = 0;
+        auto numRequired = size_t();
+        for (char ch = 0; ch < 'z' - 'a' + 1; ++ch) {
+            if (m_minCounts[ch] > m_maxCounts[ch]) {
+                m_isSatisfiable = false;
+            }
+            if (m_minCounts[ch] != 0) {
+                numRequired += m_minCounts[ch];
+                if (numRequired > NumCharacters) {
+                    m_isSatisfiable = false;
+                    break;
+                }
+                m_requiredLetters[m_numRequiredLetters++] = ch;
+            }
+        }
+    }
+
+public:
+    constexpr Constraints() {
+        for (auto& allowed : m_allowedLetters) {
+            allowed = (uint32_t(1) << ('z' - 'a' + 1)) - 1;
+        }
+    }
+
+    /**
+     * @brief Adds the clue that guessWord got the state guessState.
+     */
+    constexpr void add(Word const& guessWord, State const& guessState) {
+        auto coloredCounts = AlphabetMap<uint8_t>();
+        auto hasGrey = AlphabetMap<bool>();
+        for (size_t i = 0; i < NumCharacters; ++i) {
+            auto ch = guessWord[i];
+            auto bit = uint32_t(1) << static_cast<uint32_t>(ch);
+            if (guessState[i] == St::correct) {
+                m_allowedLetters[i] &= bit;
+                ++coloredCounts[ch];
+            } else {
+                // yellow or grey, the letter is not here
+                m_allowedLetters[i] &= ~bit;
+                if (guessState[i] == St::wrong_spot) {
+                    ++coloredCounts[ch];
+                    if (hasGrey[ch]) {
+                        // yellows are always given before the grey ones of the same letter
+                        m_isSatisfiable = false;
+                    }
+                } else {
+                    hasGrey[ch] = true;
+                }
+            }
+        }
+
+        for (size_t i = 0; i < NumCharacters; ++i) {
+            auto ch = guessWord[i];
+            m_minCounts[ch] = std::max(m_minCounts[ch], coloredCounts[ch]);
+            if (hasGrey[ch]) {
+                m_maxCounts[ch] = std::min(m_maxCounts[ch], coloredCounts[ch]);
+            }
+        }
+        updateRequiredLetters();
+    }
+
+    /**
+     * @brief Letter ch has to be at position idx.
+     */
+    constexpr void addLetterAt(size_t idx, char ch) {
+        auto bit = uint32_t(1) << static_cast<uint32_t>(ch);
+        if (0 == (m_allowedLetters[idx] & bit)) {
+            m_isSatisfiable = false;
+        }
+        m_allowedLetters[idx] &= bit;
+
+        // each position that is fixed to ch is one more ch the word has to contain
+        auto numFixed = uint8_t();
+        for (auto allowed : m_allowedLetters) {
+            if (allowed == bit) {
+                ++numFixed;
+            }
+        }
+        addMinCount(ch, numFixed);
+    }
+
+    /**
+     * @brief Letter ch has to be in the word at least count times.
+     */
+    constexpr void addMinCount(char ch, uint8_t count) {
+        m_minCounts[ch] = std::max(m_minCounts[ch], count);
+        updateRequiredLetters();
+    }
+
+    /**
+     * @brief Letter ch may be in the word at most count times.
+     */
+    constexpr void addMaxCount(char ch, uint8_t count) {
+        m_maxCounts[ch] = std::min(m_maxCounts[ch], count);
+        updateRequiredLetters();
+    }
+
+    constexpr bool operator()(Word const& word) const {
+        if (!m_isSatisfiable) {
+            return false;
+        }
+
+        // One test per position. Counting a letter compares all letters at once, see lettersEqualTo().
+        for (size_t i = 0; i < NumCharacters; ++i) {
+            auto ch = word[i];
+            if (0 == (m_allowedLetters[i] & (uint32_t(1) << static_cast<uint32_t>(ch))) ||
+                countLetters(lettersEqualTo(word, ch)) > m_maxCounts[ch]) {
+                return false;
+            }
+        }
+        for (size_t i = 0; i < m_numRequiredLetters; ++i) {
+            auto ch = m_requiredLetters[i];
+            if (countLetters(lettersEqualTo(word, ch)) < m_minCounts[ch]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Bitfield of the letters that are allowed at position idx, bit ch is set for letter ch.
+     */
+    constexpr uint32_t allowedLetters(size_t idx) const {
+        return m_allowedLetters[idx];
+    }
+
+    constexpr uint8_t minCount(char ch) const {
+        return m_minCounts[ch];
+    }
+
+    constexpr uint8_t maxCount(char ch) const {
+        return m_maxCounts[ch];
+    }
+
+    /**
+     * @brief False when the clues contradict each other, then no word passes.
+     */
+    constexpr bool isSatisfiable() const {
+        return m_isSatisfiable;
+    }
+};
+
+} // namespace wordle
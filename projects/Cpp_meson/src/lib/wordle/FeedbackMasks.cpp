@@ -0,0 +1,86 @@
+#include <util/parallel/for_each.h>
+#include <wordle/FeedbackMasks.h>
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <stdexcept>
+
+namespace wordle {
+
+FeedbackMasks::FeedbackMasks(FeedbackTable const& feedback, size_t minBucketSize, size_t minDenseWords)
+    : m_minBucketSize(minBucketSize)
+    , m_minDenseWords(minDenseWords) {
+    if (feedback.numCorrect() > WordSet::MaxWords) {
+        throw std::runtime_error("too many correct words");
+    }
+    if (feedback.numCorrect() < m_minDenseWords) {
+        // no node is ever dense, so the masks would never be used
+        return;
+    }
+    m_offsets.resize(feedback.numGuesses() + 1);
+    m_maxSparseSizes.resize(feedback.numGuesses());
+
+    // First pass: which buckets of each guess get a mask, so all masks can be stored contiguously. Rows are independent, so
+    // both passes run in parallel.
+    auto isDenseCode = std::vector<std::bitset<NumStateCodes>>(feedback.numGuesses());
+    ankerl::parallel::for_each(m_maxSparseSizes.begin(), m_maxSparseSizes.end(), [&](uint16_t& maxSparseSize) {
+        auto guessIdx = static_cast<size_t>(&maxSparseSize - m_maxSparseSizes.data());
+        auto bucketSizes = std::array<uint16_t, NumStateCodes>{};
+        auto const* codes = feedback.row(guessIdx);
+        for (size_t correctIdx = 0; correctIdx < feedback.numCorrect(); ++correctIdx) {
+            ++bucketSizes[codes[correctIdx]];
+        }
+        bucketSizes[AllCorrectStateCode] = 0;
+
+        for (size_t code = 0; code < NumStateCodes; ++code) {
+            if (bucketSizes[code] >= m_minBucketSize) {
+                isDenseCode[guessIdx].set(code);
+            } else {
+                maxSparseSize = std::max(maxSparseSize, bucketSizes[code]);
+            }
+        }
+        m_offsets[guessIdx + 1] = static_cast<uint32_t>(isDenseCode[guessIdx].count());
+    });
+    for (size_t guessIdx = 0; guessIdx < feedback.numGuesses(); ++guessIdx) {
+        m_offsets[guessIdx + 1] += m_offsets[guessIdx];
+    }
+    m_codes.resize(m_offsets.back());
+    m_masks.resize(m_offsets.back());
+
+    // Second pass: set the bits. Words of buckets without a mask go to a scratch set, so there's no unpredictable branch.
+    ankerl::parallel::for_each(m_maxSparseSizes.begin(), m_maxSparseSizes.end(), [&](uint16_t const& maxSparseSize) {
+        auto guessIdx = static_cast<size_t>(&maxSparseSize - m_maxSparseSizes.data());
+        auto scratch = WordSet();
+        auto maskOfCode = std::array<WordSet*, NumStateCodes>{};
+        auto maskIdx = m_offsets[guessIdx];
+        for (size_t code = 0; code < NumStateCodes; ++code) {
+            if (isDenseCode[guessIdx].test(code)) {
+                m_codes[maskIdx] = static_cast<uint8_t>(code);
+                maskOfCode[code] = &m_masks[maskIdx];
+                ++maskIdx;
+            } else {
+                maskOfCode[code] = &scratch;
+            }
+        }
+        auto const* codes = feedback.row(guessIdx);
+        for (size_t correctIdx = 0; correctIdx < feedback.numCorrect(); ++correctIdx) {
+            maskOfCode[codes[correctIdx]]->insert(correctIdx);
+        }
+    });
+}
+
+WordSet const* FeedbackMasks::find(size_t guessIdx, uint8_t code) const {
+    if (empty()) {
+        return nullptr;
+    }
+    auto const* codesBegin = codes(guessIdx);
+    auto const* codesEnd = m_codes.data() + m_offsets[guessIdx + 1];
+    auto const* it = std::lower_bound(codesBegin, codesEnd, code);
+    if (it == codesEnd || *it != code) {
+        return nullptr;
+    }
+    return begin(guessIdx) + (it - codesBegin);
+}
+
+} // namespace wordle
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <wordle/FeedbackTable.h>
+#include <wordle/WordSet.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace wordle {
+
+/**
+ * @brief Precalculated WordSet of the correct words that produce each state, for every (guess word, state code) pair.
+ *
+ * With these the number of remaining words after a guess is an AND plus a popcount, instead of a scan over all remaining
+ * words. Storing a set for every non-empty pair would be 1.1M sets or 330 MB for the english dictionary, so only buckets
+ * with at least minBucketSize() words get a mask. For the rest only their largest size is known, that's enough as long as
+ * one of the masks has more words left. With the default that's 110k masks, about 32 MB for english.
+ *
+ * The bucket of the guess word itself (all letters correct) never gets a mask, it is already solved.
+ */
+class FeedbackMasks {
+    size_t m_minBucketSize{};
+    size_t m_minDenseWords{};
+
+    // masks of guess word guessIdx are m_offsets[guessIdx] to m_offsets[guessIdx + 1], in increasing order of their code
+    std::vector<uint32_t> m_offsets{};
+    std::vector<uint8_t> m_codes{};
+    std::vector<WordSet> m_masks{};
+
+    // for each guess word, size of its largest bucket that has no mask
+    std::vector<uint16_t> m_maxSparseSizes{};
+
+public:
+    static constexpr size_t DefaultMinBucketSize = 64;
+
+    // Counting with the masks costs a popcount per mask and block. In nodes with a few hundred words good guesses leave all
+    // buckets smaller than minBucketSize(), then the masks can't decide and the scan is needed anyway.
+    static constexpr size_t DefaultMinDenseWords = 1024;
+
+    /**
+     * @brief No masks at all, the search always scans.
+     */
+    FeedbackMasks() = default;
+
+    /**
+     * @brief Masks for all buckets with at least minBucketSize words, the search uses them in nodes with at least
+     * minDenseWords words. When the dictionary has fewer correct words than that, there are no masks at all.
+     */
+    explicit FeedbackMasks(FeedbackTable const& feedback,
+                           size_t minBucketSize = DefaultMinBucketSize,
+                           size_t minDenseWords = DefaultMinDenseWords);
+
+    bool empty() const {
+        return m_offsets.empty();
+    }
+
+    size_t minBucketSize() const {
+        return m_minBucketSize;
+    }
+
+    /**
+     * @brief True when counting numWords remaining words with the masks is faster than scanning them.
+     */
+    bool isDense(size_t numWords) const {
+        return !empty() && numWords >= m_minDenseWords;
+    }
+
+    WordSet const* begin(size_t guessIdx) const {
+        return m_masks.data() + m_offsets[guessIdx];
+    }
+
+    WordSet const* end(size_t guessIdx) const {
+        return m_masks.data() + m_offsets[guessIdx + 1];
+    }
+
+    /**
+     * @brief State codes of the masks of guessIdx, in the same order as begin(guessIdx).
+     */
+    uint8_t const* codes(size_t guessIdx) const {
+        return m_codes.data() + m_offsets[guessIdx];
+    }
+
+    /**
+     * @brief Size of the largest bucket of guessIdx that has no mask, 0 if there is none.
+     */
+    size_t maxSparseSize(size_t guessIdx) const {
+        return m_maxSparseSizes[guessIdx];
+    }
+
+    /**
+     * @brief Mask of the correct words that produce this state code for guessIdx, or nullptr when it has no mask.
+     */
+    WordSet const* find(size_t guessIdx, uint8_t code) const;
+};
+
+} // namespace wordle
@@ -0,0 +1,144 @@
+#include <util/parallel/for_each.h>
+#include <wordle/FeedbackTable.h>
+#include <wordle/WordColumns.h>
+#include <wordle/statesFromWord.h>
+
+#include <unistd.h>
+
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+namespace wordle {
+
+namespace {
+
+// Layout of the cache file: this header, followed by numGuesses * numCorrect codes.
+struct CacheHeader {
+    std::array<char, 8> m_magic{};
+    uint32_t m_version{};
+    uint32_t m_numGuesses{};
+    uint32_t m_numCorrect{};
+    uint32_t m_reserved{};
+    uint64_t m_contentHash{};
+};
+
+constexpr auto CacheMagic = std::array<char, 8>{'w', 'o', 'r', 'd', 'l', 'e', 'f', 't'};
+
+} // namespace
+
+FeedbackTable::FeedbackTable(std::vector<Word> const& guessWords, std::vector<Word> const& correctWords)
+    : m_numGuesses(guessWords.size())
+    , m_numCorrect(correctWords.size())
+    , m_ownedCodes(guessWords.size() * correctWords.size())
+    , m_codes(m_ownedCodes.data()) {
+    if (correctWords.size() > std::numeric_limits<uint16_t>::max()) {
+        // the search stores correct word indices as uint16_t
+        throw std::runtime_error("too many correct words");
+    }
+
+    // statesFromWord() needs the correct words position-major
+    auto columns = WordColumns(correctWords);
+    auto columnPointers = columns.columnPointers();
+
+    // each row is independent, so fill them in parallel
+    ankerl::parallel::for_each(guessWords.begin(), guessWords.end(), [&](Word const& guessWord) {
+        auto guessIdx = static_cast<size_t>(&guessWord - guessWords.data());
+        statesFromWord(guessWord, columnPointers, m_numCorrect, m_ownedCodes.data() + guessIdx * m_numCorrect);
+    });
+}
+
+FeedbackTable::FeedbackTable(MappedFile&& mappedFile, size_t numGuesses, size_t numCorrect)
+    : m_numGuesses(numGuesses)
+    , m_numCorrect(numCorrect)
+    , m_mappedFile(std::move(mappedFile))
+    , m_codes(m_mappedFile->data() + sizeof(CacheHeader)) {}
+
+uint64_t FeedbackTable::contentHash(std::vector<Word> const& guessWords, std::vector<Word> const& correctWords) {
+    // FNV-1a, see http://www.isthe.com/chongo/tech/comp/fnv/
+    auto h = uint64_t(14695981039346656037U);
+    auto add = [&](uint64_t x) {
+        h = (h ^ x) * uint64_t(1099511628211U);
+    };
+    for (auto const* words : {&guessWords, &correctWords}) {
+        add(words->size());
+        for (auto const& word : *words) {
+            for (size_t i = 0; i < word.size(); ++i) {
+                add(static_cast<uint8_t>(word[i]));
+            }
+        }
+    }
+    return h;
+}
+
+bool FeedbackTable::save(std::filesystem::path const& cacheFile, uint64_t contentHash) const {
+    auto header = CacheHeader();
+    header.m_magic = CacheMagic;
+    header.m_version = CacheVersion;
+    header.m_numGuesses = static_cast<uint32_t>(m_numGuesses);
+    header.m_numCorrect = static_cast<uint32_t>(m_numCorrect);
+    header.m_contentHash = contentHash;
+
+    // Write to a temporary file first, then rename. That's atomic, so other processes never map a half written file.
+    auto tmpFile = cacheFile;
+    tmpFile += ".tmp" + std::to_string(::getpid());
+    {
+        auto fout = std::ofstream(tmpFile, std::ios::binary);
+        fout.write(reinterpret_cast<char const*>(&header), sizeof(header));
+        fout.write(reinterpret_cast<char const*>(m_codes), static_cast<std::streamsize>(m_numGuesses * m_numCorrect));
+        if (!fout) {
+            auto ec = std::error_code();
+            std::filesystem::remove(tmpFile, ec);
+            return false;
+        }
+    }
+
+    auto ec = std::error_code();
+    std::filesystem::rename(tmpFile, cacheFile, ec);
+    if (ec) {
+        std::filesystem::remove(tmpFile, ec);
+        return false;
+    }
+    return true;
+}
+
+FeedbackTable FeedbackTable::loadOrCreate(std::filesystem::path const& cacheFile,
+                                          std::vector<Word> const& guessWords,
+                                          std::vector<Word> const& correctWords) {
+    return loadOrCreate(cacheFile, guessWords, correctWords, contentHash(guessWords, correctWords));
+}
+
+FeedbackTable FeedbackTable::loadOrCreate(std::filesystem::path const& cacheFile,
+                                          std::vector<Word> const& guessWords,
+                                          std::vector<Word> const& correctWords,
+                                          uint64_t hash) {
+
+    auto ec = std::error_code();
+    if (std::filesystem::exists(cacheFile, ec)) {
+        try {
+            auto mappedFile = MappedFile(cacheFile);
+            auto header = CacheHeader();
+            if (mappedFile.size() >= sizeof(header)) {
+                std::memcpy(&header, mappedFile.data(), sizeof(header));
+            }
+            auto expectedSize = sizeof(header) + guessWords.size() * correctWords.size();
+            if (header.m_magic == CacheMagic && header.m_version == CacheVersion &&
+                header.m_numGuesses == guessWords.size() && header.m_numCorrect == correctWords.size() &&
+                header.m_contentHash == hash && mappedFile.size() == expectedSize) {
+                return FeedbackTable(std::move(mappedFile), guessWords.size(), correctWords.size());
+            }
+        } catch (std::runtime_error const&) {
+            // unusable cache, just recreate it
+        }
+    }
+
+    auto table = FeedbackTable(guessWords, correctWords);
+    table.save(cacheFile, hash);
+    return table;
+}
+
+} // namespace wordle
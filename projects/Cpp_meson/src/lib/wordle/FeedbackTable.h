@@ -0,0 +1,103 @@
+#pragma once
+
+#include <wordle/MappedFile.h>
+#include <wordle/State.h>
+#include <wordle/Word.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <vector>
+
+namespace wordle {
+
+/**
+ * @brief Precalculated state codes for every (guess word, correct word) pair.
+ *
+ * Calculating the state with stateFromWord() dominates the search, but there are only numGuesses * numCorrect different
+ * pairs. So we calculate them all once, and store each state as a single byte code (see toStateCode()). For the english
+ * dictionary that's 12972 * 2315 bytes, about 30 MB.
+ *
+ * The codes of one guess word are stored consecutively, so iterating all correct words for a guess is a linear scan.
+ *
+ * The table can be cached in a file, see loadOrCreate().
+ */
+class FeedbackTable {
+    size_t m_numGuesses{};
+    size_t m_numCorrect{};
+
+    // codes are either calculated into m_ownedCodes, or come from the cache file
+    std::vector<uint8_t> m_ownedCodes{};
+    std::optional<MappedFile> m_mappedFile{};
+    uint8_t const* m_codes{};
+
+    FeedbackTable(MappedFile&& mappedFile, size_t numGuesses, size_t numCorrect);
+
+public:
+    // increment whenever the file layout or the state codes change
+    static constexpr uint32_t CacheVersion = 1;
+
+    FeedbackTable(std::vector<Word> const& guessWords, std::vector<Word> const& correctWords);
+
+    /**
+     * @brief Maps the table from cacheFile when it matches the words, otherwise calculates the table and (re)writes the
+     * cache. When the cache can't be written, the table is still returned.
+     *
+     * The cache is keyed by a hash of both word lists, so any change to the dictionaries or their order is detected.
+     */
+    static FeedbackTable loadOrCreate(std::filesystem::path const& cacheFile,
+                                      std::vector<Word> const& guessWords,
+                                      std::vector<Word> const& correctWords);
+
+    /**
+     * @brief Same as above, with the already known contentHash() of the words.
+     */
+    static FeedbackTable loadOrCreate(std::filesystem::path const& cacheFile,
+                                      std::vector<Word> const& guessWords,
+                                      std::vector<Word> const& correctWords,
+                                      uint64_t contentHash);
+
+    /**
+     * @brief Hash of the word lists, in this order.
+     */
+    static uint64_t contentHash(std::vector<Word> const& guessWords, std::vector<Word> const& correctWords);
+
+    /**
+     * @brief Writes the table to a cache file, which is replaced atomically.
+     *
+     * @return false if that was not possible.
+     */
+    bool save(std::filesystem::path const& cacheFile, uint64_t contentHash) const;
+
+    /**
+     * @brief State code when entering guess word guessIdx, and correct word is correctIdx.
+     */
+    uint8_t operator()(size_t guessIdx, size_t correctIdx) const {
+        return m_codes[guessIdx * m_numCorrect + correctIdx];
+    }
+
+    /**
+     * @brief All numCorrect() state codes for the given guess word.
+     */
+    uint8_t const* row(size_t guessIdx) const {
+        return m_codes + guessIdx * m_numCorrect;
+    }
+
+    size_t numGuesses() const {
+        return m_numGuesses;
+    }
+
+    size_t numCorrect() const {
+        return m_numCorrect;
+    }
+
+    /**
+     * @brief True when the codes are mapped from a cache file.
+     */
+    bool isMapped() const {
+        return m_mappedFile.has_value();
+    }
+};
+
+} // namespace wordle
@@ -4,25 +4,32 @@
 #include <wordle/State.h>
 #include <wordle/Word.h>
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
 
 namespace wordle {
 
 class IsSingleWordValid {
-    AlphabetMap<uint8_t> m_charAllowed{}; // maps from character to bitfield where it's allowed.
-    AlphabetMap<uint8_t> m_mandatoryCharCount{};
-    int m_numMandatoryCharCount{};
+    // for each position, bitfield of the letters that are allowed there
+    std::array<uint32_t, NumCharacters> m_allowedLetters{};
+
+    // letters that have to be in the word, and how often at least
+    std::array<char, NumCharacters> m_mandatoryLetters{};
+    std::array<uint8_t, NumCharacters> m_mandatoryCounts{};
+    size_t m_numMandatoryLetters{};
 
 public:
-    constexpr IsSingleWordValid(Word const& guessWord, State const& guessState)
-        : m_charAllowed((1U << NumCharacters) - 1)
-        , m_mandatoryCharCount()
-        , m_numMandatoryCharCount(0) {
+    constexpr IsSingleWordValid(Word const& guessWord, State const& guessState) {
+        // maps from character to bitfield where it's allowed.
+        auto charAllowed = AlphabetMap<uint8_t>((1U << NumCharacters) - 1);
+        auto mandatoryCharCount = AlphabetMap<uint8_t>();
+
         // First, set all characters that are not allowed. Initially, everything is allowed everywhere.
         for (int i = 0; i < NumCharacters; ++i) {
             if (guessState[i] == St::not_included) {
                 // not allowed anywhere
-                m_charAllowed[guessWord[i]] = 0;
+                charAllowed[guessWord[i]] = 0;
             }
         }
 
@@ -32,14 +39,13 @@ public:
                 for (int j = 0; j < NumCharacters; ++j) {
                     if (guessWord[i] == guessWord[j]) {
                         // not allowed here
-                        m_charAllowed[guessWord[i]] &= ~(1U << j);
+                        charAllowed[guessWord[i]] &= ~(1U << j);
                     } else {
                         // allowed here
-                        m_charAllowed[guessWord[i]] |= (1U << j);
+                        charAllowed[guessWord[i]] |= (1U << j);
                     }
                 }
-                ++m_mandatoryCharCount[guessWord[i]];
-                ++m_numMandatoryCharCount;
+                ++mandatoryCharCount[guessWord[i]];
             }
         }
 
@@ -47,33 +53,65 @@ public:
         for (int i = 0; i < NumCharacters; ++i) {
             auto mask = ~(1U << i);
             if (guessState[i] == St::correct) {
-                for (auto& x : m_charAllowed) {
+                for (auto& x : charAllowed) {
                     x &= mask;
                 }
-                m_charAllowed[guessWord[i]] |= 1U << i;
-                ++m_mandatoryCharCount[guessWord[i]];
-                ++m_numMandatoryCharCount;
+                charAllowed[guessWord[i]] |= 1U << i;
+                ++mandatoryCharCount[guessWord[i]];
+            }
+        }
+
+        // transpose into what operator() needs
+        for (char ch = 0; ch < 'z' - 'a' + 1; ++ch) {
+            for (size_t i = 0; i < NumCharacters; ++i) {
+                if (charAllowed[ch] & (1U << i)) {
+                    m_allowedLetters[i] |= uint32_t(1) << static_cast<uint32_t>(ch);
+                }
+            }
+            if (mandatoryCharCount[ch] != 0) {
+                m_mandatoryLetters[m_numMandatoryLetters] = ch;
+                m_mandatoryCounts[m_numMandatoryLetters] = mandatoryCharCount[ch];
+                ++m_numMandatoryLetters;
             }
         }
     }
 
     constexpr bool operator()(Word const& checkWord) const {
-        for (int i = 0; i < NumCharacters; ++i) {
-            if (0 == (m_charAllowed[checkWord[i]] & (1U << i))) {
+        for (size_t i = 0; i < NumCharacters; ++i) {
+            if (0 == (m_allowedLetters[i] & (uint32_t(1) << static_cast<uint32_t>(checkWord[i])))) {
                 return false;
             }
         }
 
-        auto mandatoryCharCount = m_mandatoryCharCount;
-        auto numMandatoryCharCount = m_numMandatoryCharCount;
-        for (int i = 0; i < NumCharacters; ++i) {
-            if (mandatoryCharCount[checkWord[i]] != 0) {
-                --mandatoryCharCount[checkWord[i]];
-                --numMandatoryCharCount;
+        // all letters of the word are compared at once, see lettersEqualTo()
+        for (size_t i = 0; i < m_numMandatoryLetters; ++i) {
+            if (countLetters(lettersEqualTo(checkWord, m_mandatoryLetters[i])) < m_mandatoryCounts[i]) {
+                return false;
             }
         }
+        return true;
+    }
+
+    /**
+     * @brief Bitfield of the letters that are allowed at position idx, bit ch is set for letter ch.
+     */
+    constexpr uint32_t allowedLetters(size_t idx) const {
+        return m_allowedLetters[idx];
+    }
+
+    constexpr size_t numMandatoryLetters() const {
+        return m_numMandatoryLetters;
+    }
+
+    /**
+     * @brief Letter that has to be in the word at least mandatoryCount(idx) times, for idx < numMandatoryLetters().
+     */
+    constexpr char mandatoryLetter(size_t idx) const {
+        return m_mandatoryLetters[idx];
+    }
 
-        return 0 == numMandatoryCharCount;
+    constexpr uint8_t mandatoryCount(size_t idx) const {
+        return m_mandatoryCounts[idx];
     }
 };
 
@@ -0,0 +1,84 @@
+#include <wordle/Isa.h>
+
+#include <atomic>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+
+namespace wordle {
+
+namespace {
+
+std::atomic<Isa>& active() {
+    static auto isa = std::atomic<Isa>(bestIsa());
+    return isa;
+}
+
+} // namespace
+
+bool isSupported(Isa isa) {
+    switch (isa) {
+    case Isa::scalar:
+        return true;
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    // __builtin_cpu_supports queries CPUID once, and caches the result
+    case Isa::sse42:
+        return __builtin_cpu_supports("sse4.2");
+    case Isa::avx2:
+        return __builtin_cpu_supports("avx2");
+    case Isa::avx512:
+        return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw");
+#endif
+    default:
+        return false;
+    }
+}
+
+Isa bestIsa() {
+    for (auto isa : {Isa::avx512, Isa::avx2, Isa::sse42}) {
+        if (isSupported(isa)) {
+            return isa;
+        }
+    }
+    return Isa::scalar;
+}
+
+Isa activeIsa() {
+    return active().load(std::memory_order_relaxed);
+}
+
+void forceIsa(Isa isa) {
+    if (!isSupported(isa)) {
+        throw std::runtime_error("instruction set " + std::string(isaName(isa)) + " is not supported");
+    }
+    active().store(isa, std::memory_order_relaxed);
+}
+
+Isa parseIsa(std::string_view name) {
+    for (auto isa : {Isa::scalar, Isa::sse42, Isa::avx2, Isa::avx512}) {
+        if (name == isaName(isa)) {
+            return isa;
+        }
+    }
+    throw std::runtime_error("unknown instruction set " + std::string(name));
+}
+
+std::string_view isaName(Isa isa) {
+    switch (isa) {
+    case Isa::scalar:
+        return "scalar";
+    case Isa::sse42:
+        return "sse4.2";
+    case Isa::avx2:
+        return "avx2";
+    case Isa::avx512:
+        return "avx512";
+    }
+    return "unknown";
+}
+
+std::ostream& operator<<(std::ostream& os, Isa isa) {
+    return os << isaName(isa);
+}
+
+} // namespace wordle
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+#include <string_view>
+
+namespace wordle {
+
+/**
+ * @brief Instruction set variants of the vectorized kernels.
+ *
+ * The kernels are compiled for each of these, and the best one the CPU supports is selected once at startup. Ordered from
+ * the most basic to the widest.
+ */
+enum class Isa : uint8_t { scalar, sse42, avx2, avx512 };
+
+/**
+ * @brief True if this build contains the variant and the CPU can run it.
+ */
+bool isSupported(Isa isa);
+
+/**
+ * @brief The widest supported variant.
+ */
+Isa bestIsa();
+
+/**
+ * @brief The variant that is used by all kernels. Defaults to bestIsa().
+ */
+Isa activeIsa();
+
+/**
+ * @brief Uses the given variant from now on, e.g. for benchmarking. Throws std::runtime_error when it isn't supported.
+ */
+void forceIsa(Isa isa);
+
+/**
+ * @brief Parses "scalar", "sse4.2", "avx2" or "avx512". Throws std::runtime_error for anything else.
+ */
+Isa parseIsa(std::string_view name);
+
+/**
+ * @brief Name of the variant, as accepted by parseIsa().
+ */
+std::string_view isaName(Isa isa);
+
+std::ostream& operator<<(std::ostream& os, Isa isa);
+
+} // namespace wordle
@@ -0,0 +1,55 @@
+#include <wordle/MappedFile.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <stdexcept>
+#include <utility>
+
+namespace wordle {
+
+MappedFile::MappedFile(std::filesystem::path const& filename) {
+    auto fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd == -1) {
+        throw std::runtime_error("Could not open " + filename.string());
+    }
+
+    struct stat st {};
+    if (::fstat(fd, &st) == -1) {
+        ::close(fd);
+        throw std::runtime_error("Could not stat " + filename.string());
+    }
+
+    // mapping 0 bytes is not allowed, an empty file simply has no data
+    m_size = static_cast<size_t>(st.st_size);
+    if (m_size != 0) {
+        m_data = ::mmap(nullptr, m_size, PROT_READ, MAP_SHARED, fd, 0);
+    }
+    // the mapping stays valid after closing
+    ::close(fd);
+
+    if (m_data == MAP_FAILED) {
+        m_data = nullptr;
+        throw std::runtime_error("Could not map " + filename.string());
+    }
+}
+
+MappedFile::~MappedFile() {
+    if (m_data != nullptr) {
+        ::munmap(m_data, m_size);
+    }
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : m_data(std::exchange(other.m_data, nullptr))
+    , m_size(std::exchange(other.m_size, 0)) {}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    std::swap(m_data, other.m_data);
+    std::swap(m_size, other.m_size);
+    return *this;
+}
+
+} // namespace wordle
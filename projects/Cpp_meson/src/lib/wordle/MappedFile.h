@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+namespace wordle {
+
+/**
+ * @brief Read-only memory mapping of a whole file.
+ *
+ * Pages are loaded lazily by the OS, and all processes that map the same file share the same physical pages through the
+ * page cache.
+ */
+class MappedFile {
+    void* m_data = nullptr;
+    size_t m_size = 0;
+
+public:
+    /**
+     * @brief Maps the file, throws std::runtime_error when that's not possible.
+     */
+    explicit MappedFile(std::filesystem::path const& filename);
+    ~MappedFile();
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(MappedFile const&) = delete;
+    MappedFile& operator=(MappedFile const&) = delete;
+
+    uint8_t const* data() const {
+        return static_cast<uint8_t const*>(m_data);
+    }
+
+    size_t size() const {
+        return m_size;
+    }
+};
+
+} // namespace wordle
@@ -0,0 +1,192 @@
+#include <wordle/Server.h>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+
+namespace wordle {
+
+namespace {
+
+void setNonBlocking(int fd) {
+    ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+}
+
+// True when a failed read or send just has to be tried again later
+bool isTemporaryError() {
+    return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+}
+
+// Sends as much of output as the socket takes without blocking, and removes that from output. Returns false when the client
+// went away. MSG_NOSIGNAL prevents SIGPIPE.
+bool sendSome(int fd, std::string& output) {
+    while (!output.empty()) {
+        auto numSent = ::send(fd, output.data(), output.size(), MSG_NOSIGNAL);
+        if (numSent < 0) {
+            return isTemporaryError();
+        }
+        output.erase(0, static_cast<size_t>(numSent));
+    }
+    return true;
+}
+
+} // namespace
+
+Server::Server(std::filesystem::path dictionaryDir, size_t maxDepth, std::optional<std::chrono::milliseconds> timeBudget)
+    : m_dictionaryDir(std::move(dictionaryDir))
+    , m_maxDepth(maxDepth)
+    , m_timeBudget(timeBudget) {}
+
+Dictionary const& Server::dictionary(std::string const& name) {
+    auto it = m_dictionaries.find(name);
+    if (it == m_dictionaries.end()) {
+        // only plain names, requests must not reach other files
+        auto isValidName = !name.empty() && std::all_of(name.begin(), name.end(), [](char ch) {
+            return (ch >= 'a' && ch <= 'z') || (ch >= '0' && ch <= '9') || ch == '_' || ch == '-';
+        });
+        if (!isValidName) {
+            throw std::runtime_error("invalid dictionary name '" + name + "'");
+        }
+        auto prefix = (m_dictionaryDir / name).string();
+        auto ec = std::error_code();
+        if (std::filesystem::exists(prefix + ".wdb", ec)) {
+            prefix += ".wdb";
+        }
+        it = m_dictionaries.emplace(name, loadDictionary(prefix)).first;
+        std::cout << "loaded " << prefix << ": " << it->second.m_allowedWords.size() << " allowed, "
+                  << it->second.m_correctWords.size() << " correct words" << std::endl;
+    }
+    return it->second;
+}
+
+std::string Server::answer(std::string_view request) {
+    auto startTime = std::chrono::steady_clock::now();
+    auto in = std::istringstream(std::string(request));
+    auto name = std::string();
+    if (!(in >> name)) {
+        throw std::runtime_error("empty request");
+    }
+    auto const& dict = dictionary(name);
+
+    auto clues = std::string();
+    std::getline(in, clues);
+    if (auto queryAnswer = answerQuery(dict, clues)) {
+        return *queryAnswer;
+    }
+    auto cluesStream = std::istringstream(clues);
+    auto remainingCorrectWords = filterCorrectWords(dict, parseClues(cluesStream));
+    if (remainingCorrectWords.empty()) {
+        throw std::runtime_error("no correct word matches the clues");
+    }
+
+    auto deadline = std::optional<std::chrono::steady_clock::time_point>();
+    if (m_timeBudget) {
+        deadline = startTime + *m_timeBudget;
+    }
+    auto result = solve(dict, remainingCorrectWords, m_transpositions, m_maxDepth, deadline, false, true);
+
+    auto out = std::ostringstream();
+    out << result.m_fitness << " " << dict.word(result.m_guessId);
+    return out.str();
+}
+
+std::string Server::respond(std::string_view request) {
+    try {
+        return answer(request);
+    } catch (std::exception const& e) {
+        return std::string("error: ") + e.what();
+    }
+}
+
+bool Server::receive(Client& client, std::string_view data) {
+    client.m_input.append(data.data(), data.size());
+    auto lineBegin = size_t();
+    for (auto eol = client.m_input.find('\n'); eol != std::string::npos; eol = client.m_input.find('\n', lineBegin)) {
+        client.m_output += respond(std::string_view(client.m_input).substr(lineBegin, eol - lineBegin));
+        client.m_output += '\n';
+        lineBegin = eol + 1;
+    }
+    client.m_input.erase(0, lineBegin);
+    return client.m_input.size() <= MaxRequestSize;
+}
+
+void Server::run(std::string const& socketPath) {
+    auto addr = sockaddr_un();
+    addr.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(addr.sun_path)) {
+        throw std::runtime_error("socket path too long: " + socketPath);
+    }
+    std::copy(socketPath.begin(), socketPath.end(), addr.sun_path);
+
+    auto listenFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd == -1) {
+        throw std::runtime_error("socket() failed");
+    }
+    // a socket file from an earlier run would make bind() fail
+    ::unlink(socketPath.c_str());
+    if (::bind(listenFd, reinterpret_cast<sockaddr const*>(&addr), sizeof(addr)) != 0 ||
+        ::listen(listenFd, SOMAXCONN) != 0) {
+        ::close(listenFd);
+        throw std::runtime_error("could not listen on " + socketPath);
+    }
+    setNonBlocking(listenFd);
+    std::cout << "listening on " << socketPath << std::endl;
+
+    // first entry is the listening socket, then one per client
+    auto fds = std::vector<pollfd>{{listenFd, POLLIN, 0}};
+    auto clients = std::vector<Client>(1);
+    auto readBuffer = std::array<char, 4096>();
+    while (true) {
+        if (::poll(fds.data(), fds.size(), -1) < 0) {
+            continue;
+        }
+        for (size_t i = fds.size() - 1; i > 0; --i) {
+            auto& pfd = fds[i];
+            auto& client = clients[i];
+            if (pfd.revents == 0) {
+                continue;
+            }
+            auto isConnected = (pfd.revents & (POLLERR | POLLNVAL)) == 0;
+            if (isConnected && (pfd.revents & (POLLIN | POLLHUP)) != 0) {
+                auto numRead = ::read(pfd.fd, readBuffer.data(), readBuffer.size());
+                if (numRead > 0) {
+                    isConnected = receive(client, std::string_view(readBuffer.data(), static_cast<size_t>(numRead)));
+                } else {
+                    isConnected = numRead < 0 && isTemporaryError();
+                }
+            }
+            if (isConnected) {
+                isConnected = sendSome(pfd.fd, client.m_output);
+            }
+            if (!isConnected) {
+                ::close(pfd.fd);
+                fds.erase(fds.begin() + static_cast<std::ptrdiff_t>(i));
+                clients.erase(clients.begin() + static_cast<std::ptrdiff_t>(i));
+                continue;
+            }
+            // Don't read more requests while responses are pending, so a client that doesn't read can't make its queue grow.
+            pfd.events = client.m_output.empty() ? POLLIN : POLLOUT;
+        }
+        if (fds[0].revents & POLLIN) {
+            auto clientFd = ::accept(listenFd, nullptr, nullptr);
+            if (clientFd != -1) {
+                setNonBlocking(clientFd);
+                fds.push_back({clientFd, POLLIN, 0});
+                clients.emplace_back();
+            }
+        }
+    }
+}
+
+} // namespace wordle
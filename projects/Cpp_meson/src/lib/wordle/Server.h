@@ -0,0 +1,76 @@
+#pragma once
+
+#include <wordle/TranspositionTable.h>
+#include <wordle/solve.h>
+
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace wordle {
+
+/**
+ * @brief Solver that keeps dictionaries, feedback tables and the thread pool loaded between requests.
+ *
+ * A request is one line "<name> [word-state]...", e.g. "en weary00102 yelps10000". name selects the dictionary
+ * <dictionaryDir>/<name>.wdb, or <name>_allowed.txt and <name>_correct.txt when there's no such file. It's loaded on first
+ * use. The answer is one line "<fitness> <guess>", or "error: <message>". A request "<name> query <pattern> [word-state]..."
+ * lists the matching allowed words instead, see answerQuery().
+ */
+class Server {
+    std::filesystem::path m_dictionaryDir;
+    size_t m_maxDepth;
+    std::optional<std::chrono::milliseconds> m_timeBudget;
+
+    std::unordered_map<std::string, Dictionary> m_dictionaries{};
+    TranspositionTable<Result> m_transpositions{1U << 18U};
+
+    Dictionary const& dictionary(std::string const& name);
+
+public:
+    // Longest request line that's accepted. A client that sends more without a newline is disconnected.
+    static constexpr size_t MaxRequestSize = 4096;
+
+    // What run() keeps for each connected client
+    struct Client {
+        // received bytes of the request line that's not complete yet
+        std::string m_input{};
+
+        // responses that couldn't be sent yet
+        std::string m_output{};
+    };
+
+    Server(std::filesystem::path dictionaryDir, size_t maxDepth, std::optional<std::chrono::milliseconds> timeBudget);
+
+    /**
+     * @brief Answers a single request, without the trailing newline. Throws std::runtime_error for invalid requests.
+     */
+    std::string answer(std::string_view request);
+
+    /**
+     * @brief Same as answer(), but errors are returned as "error: <message>". This is what clients receive.
+     */
+    std::string respond(std::string_view request);
+
+    /**
+     * @brief Appends data received from client, and queues the response of each complete line in its output.
+     *
+     * Returns false when the line that's left has more than MaxRequestSize bytes, then the client has to be dropped.
+     */
+    bool receive(Client& client, std::string_view data);
+
+    /**
+     * @brief Listens on the Unix socket socketPath and answers requests of all clients, one at a time. Never returns.
+     *
+     * Each search already uses all threads, so requests are answered in the order they arrive. Sockets are non-blocking, so a
+     * client that doesn't read its responses never stalls the others: they are queued, and nothing more is read from that
+     * client until its queue is sent.
+     */
+    [[noreturn]] void run(std::string const& socketPath);
+};
+
+} // namespace wordle
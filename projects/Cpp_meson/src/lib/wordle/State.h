@@ -52,6 +52,38 @@ public:
     }
 };
 
+// Number of different fully specified states: 3^NumCharacters.
+static constexpr auto NumStateCodes = 243;
+
+// Code of the state where all letters are correct, "22222".
+static constexpr auto AllCorrectStateCode = uint8_t(NumStateCodes - 1);
+
+/**
+ * @brief Encodes a fully specified state (only 0, 1, 2) as a base-3 number.
+ *
+ * The first letter is the most significant digit, so "00000" is 0, "00001" is 1, and "22222" is 242. The code fits into a
+ * single byte, which makes it ideal for tables.
+ */
+constexpr uint8_t toStateCode(State const& state) {
+    auto code = 0;
+    for (size_t i = 0; i < NumCharacters; ++i) {
+        code = code * 3 + (static_cast<int>(state[i]) - static_cast<int>(St::not_included));
+    }
+    return static_cast<uint8_t>(code);
+}
+
+/**
+ * @brief Inverse of toStateCode().
+ */
+constexpr State fromStateCode(uint8_t code) {
+    auto state = State();
+    for (size_t i = NumCharacters; i != 0; --i) {
+        state[i - 1] = static_cast<St>(code % 3 + static_cast<int>(St::not_included));
+        code /= 3;
+    }
+    return state;
+}
+
 std::ostream& operator<<(std::ostream& os, State const& s);
 
 } // namespace wordle
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <thread>
+
+namespace wordle {
+
+/**
+ * @brief What we know about a stored search value, see https://www.chessprogramming.org/Transposition_Table
+ *
+ * exact: the value is the real minimax value.
+ * lower: search was cut off with value >= beta, the real value is at least value.
+ * upper: search was cut off with value <= alpha, the real value is at most value.
+ */
+enum class Bound : uint8_t { exact, lower, upper };
+
+/**
+ * @brief Size bounded hash table that remembers search results, and can be used concurrently by many threads.
+ *
+ * Different guess sequences often leave exactly the same set of remaining words, so it pays off to remember what we've
+ * already calculated. The table never grows; each bucket has two entries: the first one keeps the result closest to the root
+ * (these are the most expensive ones), the second one is always replaced.
+ *
+ * Each bucket is guarded by a tiny spinlock. Since lookups are very short and spread over many buckets, there's hardly any
+ * contention.
+ */
+template <typename Value>
+class TranspositionTable {
+public:
+    struct Entry {
+        uint64_t m_key{};
+        Value m_value{};
+        uint8_t m_depth{};
+        Bound m_bound{};
+    };
+
+private:
+    struct Bucket {
+        std::atomic<bool> m_isLocked{};
+        uint8_t m_numEntries{};
+        std::array<Entry, 2> m_entries{};
+    };
+
+    class LockGuard {
+        std::atomic<bool>& m_isLocked;
+
+    public:
+        explicit LockGuard(std::atomic<bool>& isLocked)
+            : m_isLocked(isLocked) {
+            while (m_isLocked.exchange(true, std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+        }
+
+        ~LockGuard() {
+            m_isLocked.store(false, std::memory_order_release);
+        }
+
+        LockGuard(LockGuard const&) = delete;
+        LockGuard& operator=(LockGuard const&) = delete;
+    };
+
+    std::unique_ptr<Bucket[]> m_buckets;
+    size_t m_mask;
+
+    Bucket& bucket(uint64_t key) const {
+        return m_buckets[key & m_mask];
+    }
+
+public:
+    /**
+     * @brief Creates a table with at least the given number of buckets (rounded up to a power of two).
+     */
+    explicit TranspositionTable(size_t minNumBuckets) {
+        auto numBuckets = size_t(1);
+        while (numBuckets < minNumBuckets) {
+            numBuckets *= 2;
+        }
+        m_buckets = std::make_unique<Bucket[]>(numBuckets);
+        m_mask = numBuckets - 1;
+    }
+
+    /**
+     * @brief Finds an entry for exactly this key and depth.
+     */
+    std::optional<Entry> find(uint64_t key, size_t depth) const {
+        auto& b = bucket(key);
+        auto lock = LockGuard(b.m_isLocked);
+        for (uint8_t i = 0; i < b.m_numEntries; ++i) {
+            auto const& entry = b.m_entries[i];
+            if (entry.m_key == key && entry.m_depth == depth) {
+                return entry;
+            }
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Stores the value. A lower depth is closer to the root, so it was more expensive to calculate.
+     */
+    void store(uint64_t key, size_t depth, Bound bound, Value const& value) {
+        auto entry = Entry{key, value, static_cast<uint8_t>(depth), bound};
+
+        auto& b = bucket(key);
+        auto lock = LockGuard(b.m_isLocked);
+        auto& first = b.m_entries[0];
+        if (b.m_numEntries == 0 || (first.m_key == key && first.m_depth == depth) || depth <= first.m_depth) {
+            // move previous first entry to the always-replace slot, unless it is the same
+            if (b.m_numEntries != 0 && (first.m_key != key || first.m_depth != depth)) {
+                b.m_entries[1] = first;
+                b.m_numEntries = 2;
+            } else if (b.m_numEntries == 0) {
+                b.m_numEntries = 1;
+            }
+            first = entry;
+        } else {
+            b.m_entries[1] = entry;
+            b.m_numEntries = 2;
+        }
+    }
+
+    /**
+     * @brief Removes all entries. Must not be called while other threads use the table.
+     */
+    void clear() {
+        for (size_t i = 0; i <= m_mask; ++i) {
+            m_buckets[i].m_numEntries = 0;
+        }
+    }
+
+    size_t numBuckets() const {
+        return m_mask + 1;
+    }
+};
+
+} // namespace wordle
@@ -5,8 +5,8 @@
 namespace wordle {
 
 std::ostream& operator<<(std::ostream& os, Word const& w) {
-    for (auto ch : w) {
-        os << static_cast<char>(ch + 'a');
+    for (size_t i = 0; i < w.size(); ++i) {
+        os << static_cast<char>(w[i] + 'a');
     }
     return os;
 }
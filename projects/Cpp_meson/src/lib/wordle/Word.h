@@ -1,6 +1,7 @@
 #pragma once
 
-#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <iosfwd>
 
 namespace wordle {
@@ -8,58 +9,85 @@ namespace wordle {
 // hardcoded constant - all words have these many characters
 static constexpr auto NumCharacters = 5;
 
-// Word stores byte 0-26 ('a' to 'z').
+// Word stores letters 0-25 ('a' to 'z'), packed with 5 bits each into one integer. Letter i is in bits [5 * i, 5 * i + 5),
+// so comparing and copying words are single integer operations, and all letters can be processed at once (SWAR).
 class Word {
-    std::array<char, NumCharacters> m_data{};
+    uint32_t m_bits{};
 
 public:
-    constexpr char& operator[](size_t idx) {
-        return m_data[idx];
-    }
+    static constexpr auto BitsPerLetter = 5U;
+    static constexpr auto LetterMask = uint32_t((1U << BitsPerLetter) - 1);
 
-    constexpr char const& operator[](size_t idx) const {
-        return m_data[idx];
-    }
+    // lowest bit of each letter
+    static constexpr auto LowBits = uint32_t(0b00001'00001'00001'00001'00001);
 
-    constexpr size_t size() const {
-        return m_data.size();
-    }
+    constexpr Word() = default;
 
-    constexpr char const* data() const {
-        return m_data.data();
+    static constexpr Word fromBits(uint32_t bits) {
+        auto w = Word();
+        w.m_bits = bits;
+        return w;
     }
 
-    constexpr auto begin() const {
-        return m_data.begin();
+    constexpr char operator[](size_t idx) const {
+        return static_cast<char>((m_bits >> (idx * BitsPerLetter)) & LetterMask);
     }
 
-    constexpr auto begin() {
-        return m_data.begin();
+    constexpr void set(size_t idx, char ch) {
+        auto shift = idx * BitsPerLetter;
+        m_bits = (m_bits & ~(LetterMask << shift)) | (static_cast<uint32_t>(ch) << shift);
     }
 
-    constexpr auto end() const {
-        return m_data.end();
+    constexpr size_t size() const {
+        return NumCharacters;
     }
 
-    constexpr auto end() {
-        return m_data.end();
+    constexpr uint32_t bits() const {
+        return m_bits;
     }
 
     constexpr bool operator==(Word const& other) const {
-        // can't use std::array's == because it's not constexpr
-        for (size_t i = 0; i < size(); ++i) {
-            if (m_data[i] != other.m_data[i]) {
-                return false;
-            }
-        }
-        return true;
+        return m_bits == other.m_bits;
     }
 
     constexpr bool operator!=(Word const& other) const {
-        return !(*this == other);
+        return m_bits != other.m_bits;
     }
 };
 
+/**
+ * @brief Sets the lowest bit of each 5 bit letter of x that is zero, all other bits are cleared.
+ */
+constexpr uint32_t zeroLetters(uint32_t x) {
+    // OR bits 0-4 of each letter into its lowest bit. Other bits get garbage from the next letter, but they are masked out.
+    auto y = x | (x >> 1U);
+    y |= y >> 2U;
+    y |= x >> 4U;
+    return ~y & Word::LowBits;
+}
+
+/**
+ * @brief Lowest bit of each letter is set where a and b have the same letter.
+ */
+constexpr uint32_t matchingLetters(Word const& a, Word const& b) {
+    return zeroLetters(a.bits() ^ b.bits());
+}
+
+/**
+ * @brief Lowest bit of each letter is set where word has the letter ch.
+ */
+constexpr uint32_t lettersEqualTo(Word const& word, char ch) {
+    return zeroLetters(word.bits() ^ (Word::LowBits * static_cast<uint32_t>(ch)));
+}
+
+/**
+ * @brief Number of letters in a mask from matchingLetters() or lettersEqualTo().
+ */
+constexpr int countLetters(uint32_t mask) {
+    // The multiplication adds all lowest bits into the last letter. At most 5, so nothing overflows into other letters.
+    return static_cast<int>(((mask * Word::LowBits) >> ((NumCharacters - 1) * Word::BitsPerLetter)) & Word::LetterMask);
+}
+
 std::ostream& operator<<(std::ostream& os, Word const& w);
 
 } // namespace wordle
@@ -0,0 +1,263 @@
+#include <wordle/Isa.h>
+#include <wordle/WordColumns.h>
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#    define WORDLE_HAS_X86_KERNELS 1
+#    include <immintrin.h>
+#endif
+
+namespace wordle {
+
+namespace {
+
+constexpr auto NumLetters = size_t('z' - 'a' + 1);
+constexpr auto AllLetters = uint32_t((1U << NumLetters) - 1);
+
+// What the kernels check, derived from the Constraints once per filter() call.
+struct FilterSpec {
+    // For each position, bitfield of the letters allowed there. A letter with a maximum count of 0 is removed everywhere, so
+    // it doesn't have to be counted.
+    std::array<uint32_t, NumCharacters> m_allowedLetters{};
+
+    // letters whose count in the word is limited, with their minimum and maximum count
+    std::array<char, NumLetters> m_countedLetters{};
+    std::array<uint8_t, NumLetters> m_minCounts{};
+    std::array<uint8_t, NumLetters> m_maxCounts{};
+    size_t m_numCountedLetters{};
+
+    explicit FilterSpec(Constraints const& constraints) {
+        auto forbidden = uint32_t();
+        for (char ch = 0; ch < static_cast<char>(NumLetters); ++ch) {
+            auto minCount = constraints.minCount(ch);
+            auto maxCount = constraints.maxCount(ch);
+            if (maxCount == 0) {
+                forbidden |= uint32_t(1) << static_cast<uint32_t>(ch);
+            } else if (minCount != 0 || maxCount < NumCharacters) {
+                m_countedLetters[m_numCountedLetters] = ch;
+                m_minCounts[m_numCountedLetters] = minCount;
+                m_maxCounts[m_numCountedLetters] = maxCount;
+                ++m_numCountedLetters;
+            }
+        }
+        for (size_t i = 0; i < NumCharacters; ++i) {
+            m_allowedLetters[i] = constraints.allowedLetters(i) & ~forbidden;
+        }
+    }
+};
+
+std::vector<uint32_t> filterScalar(WordColumns const& words, Constraints const& constraints) {
+    // most words contain a letter that is allowed nowhere, and that's a single test with the letter masks
+    auto spec = FilterSpec(constraints);
+    auto allowedSomewhere = uint32_t();
+    for (auto allowed : spec.m_allowedLetters) {
+        allowedSomewhere |= allowed;
+    }
+    auto forbiddenEverywhere = ~allowedSomewhere & AllLetters;
+
+    auto indices = std::vector<uint32_t>();
+    for (size_t idx = 0; idx < words.size(); ++idx) {
+        if ((words.letterMasks()[idx] & forbiddenEverywhere) == 0 && constraints(words.word(idx))) {
+            indices.push_back(static_cast<uint32_t>(idx));
+        }
+    }
+    return indices;
+}
+
+#if defined(WORDLE_HAS_X86_KERNELS)
+
+// Vector types for Width words, and a 16 entry table lookup for each byte lane (pshufb). The lookup works within each 16
+// byte part of the register, so tables are repeated for wider registers. GCC loses vector_size attributes that depend on a
+// template parameter, so everything is spelled out.
+//
+// lookup() is not always_inline, because it needs its instruction set. It's inlined once filterVector() is inside a kernel
+// with the same instruction set. Vectors are passed by reference, so the ABI doesn't depend on the instruction set.
+template <size_t Width>
+struct FilterVectors;
+
+template <>
+struct FilterVectors<16> {
+    typedef signed char Letters __attribute__((vector_size(16)));
+
+    __attribute__((target("sse4.2"))) static void lookup(Letters const& table, Letters const& idx, Letters& result) {
+        result = reinterpret_cast<Letters>(
+            _mm_shuffle_epi8(reinterpret_cast<__m128i>(table), reinterpret_cast<__m128i>(idx)));
+    }
+};
+
+template <>
+struct FilterVectors<32> {
+    typedef signed char Letters __attribute__((vector_size(32)));
+
+    __attribute__((target("avx2"))) static void lookup(Letters const& table, Letters const& idx, Letters& result) {
+        result = reinterpret_cast<Letters>(
+            _mm256_shuffle_epi8(reinterpret_cast<__m256i>(table), reinterpret_cast<__m256i>(idx)));
+    }
+};
+
+template <>
+struct FilterVectors<64> {
+    typedef signed char Letters __attribute__((vector_size(64)));
+
+    __attribute__((target("avx512f,avx512bw"))) static void
+    lookup(Letters const& table, Letters const& idx, Letters& result) {
+        result = reinterpret_cast<Letters>(
+            _mm512_shuffle_epi8(reinterpret_cast<__m512i>(table), reinterpret_cast<__m512i>(idx)));
+    }
+};
+
+// Written once with the compiler's vector extensions, and inlined into a function for each instruction set like
+// statesFromWordVector(). Each byte lane works on one word, comparisons produce -1 for true.
+template <size_t Width>
+__attribute__((always_inline)) inline std::vector<uint32_t> filterVector(WordColumns const& words,
+                                                                        Constraints const& constraints) {
+    using Vectors = FilterVectors<Width>;
+    using Vec = typename Vectors::Letters;
+
+    auto spec = FilterSpec(constraints);
+
+    // For each position, -1 for the allowed letters. Letters 0-15 are looked up in allowedLow, 16-31 in allowedHigh. The
+    // padding value 31 is never allowed.
+    Vec allowedLow[NumCharacters];
+    Vec allowedHigh[NumCharacters];
+    for (size_t i = 0; i < NumCharacters; ++i) {
+        auto allowed = spec.m_allowedLetters[i];
+        for (size_t lane = 0; lane < Width; ++lane) {
+            allowedLow[i][lane] = static_cast<signed char>(-static_cast<int>((allowed >> (lane % 16)) & 1U));
+            allowedHigh[i][lane] = static_cast<signed char>(-static_cast<int>((allowed >> (lane % 16 + 16)) & 1U));
+        }
+    }
+
+    // For each counted letter, -1 for the counts between its minimum and maximum. Comparing the count with both limits would
+    // do the same, but then GCC scalarizes the AVX-512 loop.
+    Vec validCounts[NumLetters];
+    for (size_t k = 0; k < spec.m_numCountedLetters; ++k) {
+        for (size_t lane = 0; lane < Width; ++lane) {
+            auto count = lane % 16;
+            validCounts[k][lane] =
+                static_cast<signed char>(count >= spec.m_minCounts[k] && count <= spec.m_maxCounts[k] ? -1 : 0);
+        }
+    }
+
+    auto indices = std::vector<uint32_t>();
+    for (size_t w = 0; w < words.size(); w += Width) {
+        Vec columns[NumCharacters];
+        for (size_t i = 0; i < NumCharacters; ++i) {
+            std::memcpy(&columns[i], words.column(i) + w, Width);
+        }
+
+        Vec isValid = columns[0] == columns[0];
+        for (size_t i = 0; i < NumCharacters; ++i) {
+            // the lookup only uses the lowest 4 bits of the letter
+            Vec low;
+            Vec high;
+            Vectors::lookup(allowedLow[i], columns[i], low);
+            Vectors::lookup(allowedHigh[i], columns[i], high);
+            Vec isHigh = columns[i] > 15;
+            isValid &= (low & ~isHigh) | (high & isHigh);
+        }
+
+        for (size_t k = 0; k < spec.m_numCountedLetters; ++k) {
+            Vec count = {};
+            for (size_t i = 0; i < NumCharacters; ++i) {
+                count -= columns[i] == spec.m_countedLetters[k];
+            }
+            Vec isCountValid;
+            Vectors::lookup(validCounts[k], count, isCountValid);
+            isValid &= isCountValid;
+        }
+
+        // Most blocks have no valid word at all, so look at 8 lanes at once. Keep only the lowest bit of each lane.
+        uint64_t lanes[Width / 8];
+        std::memcpy(lanes, &isValid, sizeof(lanes));
+        for (size_t part = 0; part < Width / 8; ++part) {
+            for (auto bits = lanes[part] & uint64_t(0x0101010101010101); bits != 0; bits &= bits - 1) {
+                auto idx = w + part * 8 + static_cast<size_t>(__builtin_ctzll(bits)) / 8;
+                // the padding words after the end are never valid
+                if (idx < words.size()) {
+                    indices.push_back(static_cast<uint32_t>(idx));
+                }
+            }
+        }
+    }
+    return indices;
+}
+
+__attribute__((target("sse4.2"))) std::vector<uint32_t> filterSse42(WordColumns const& words,
+                                                                    Constraints const& constraints) {
+    return filterVector<16>(words, constraints);
+}
+
+__attribute__((target("avx2"))) std::vector<uint32_t> filterAvx2(WordColumns const& words,
+                                                                 Constraints const& constraints) {
+    return filterVector<32>(words, constraints);
+}
+
+__attribute__((target("avx512f,avx512bw"))) std::vector<uint32_t> filterAvx512(WordColumns const& words,
+                                                                               Constraints const& constraints) {
+    return filterVector<64>(words, constraints);
+}
+
+#endif
+
+} // namespace
+
+WordColumns::WordColumns(std::vector<Word> const& words)
+    : m_size(words.size()) {
+    // at least one block, so column() always has something to point to
+    auto numBlocks = std::max<size_t>(1, (words.size() + BlockSize - 1) / BlockSize);
+    for (auto& column : m_columns) {
+        column.resize(numBlocks);
+        for (auto& block : column) {
+            // padding gets a value that no letter has
+            block.m_letters.fill(static_cast<char>(Word::LetterMask));
+        }
+    }
+    m_letterMasks.resize(numBlocks * BlockSize);
+
+    for (size_t idx = 0; idx < words.size(); ++idx) {
+        for (size_t i = 0; i < NumCharacters; ++i) {
+            auto ch = words[idx][i];
+            m_columns[i][idx / BlockSize].m_letters[idx % BlockSize] = ch;
+            m_letterMasks[idx] |= uint32_t(1) << static_cast<uint32_t>(ch);
+        }
+    }
+}
+
+WordColumnPointers WordColumns::columnPointers() const {
+    auto pointers = WordColumnPointers();
+    for (size_t i = 0; i < NumCharacters; ++i) {
+        pointers[i] = column(i);
+    }
+    return pointers;
+}
+
+Word WordColumns::word(size_t idx) const {
+    auto w = Word();
+    for (size_t i = 0; i < NumCharacters; ++i) {
+        w.set(i, column(i)[idx]);
+    }
+    return w;
+}
+
+std::vector<uint32_t> WordColumns::filter(Constraints const& constraints) const {
+    if (!constraints.isSatisfiable()) {
+        return {};
+    }
+    switch (activeIsa()) {
+#if defined(WORDLE_HAS_X86_KERNELS)
+    case Isa::avx512:
+        return filterAvx512(*this, constraints);
+    case Isa::avx2:
+        return filterAvx2(*this, constraints);
+    case Isa::sse42:
+        return filterSse42(*this, constraints);
+#endif
+    default:
+        return filterScalar(*this, constraints);
+    }
+}
+
+} // namespace wordle
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <wordle/Constraints.h>
+#include <wordle/Word.h>
+#include <wordle/statesFromWord.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace wordle {
+
+/**
+ * @brief Words stored as structure of arrays: one column of letters per position, plus the letters each word contains.
+ *
+ * Letter i of all words is contiguous, so kernels load one register of letters for many words at once. Columns are 64 byte
+ * aligned and padded to a multiple of BlockSize words, so a kernel never needs a scalar tail.
+ */
+class WordColumns {
+public:
+    static constexpr size_t BlockSize = 64;
+
+private:
+    struct alignas(BlockSize) Block {
+        std::array<char, BlockSize> m_letters;
+    };
+
+    size_t m_size{};
+    std::array<std::vector<Block>, NumCharacters> m_columns{};
+
+    std::vector<uint32_t> m_letterMasks{};
+
+public:
+    explicit WordColumns(std::vector<Word> const& words);
+
+    size_t size() const {
+        return m_size;
+    }
+
+    /**
+     * @brief Letters at position pos of all words, 64 byte aligned. Can be read up to the next multiple of BlockSize.
+     */
+    char const* column(size_t pos) const {
+        return m_columns[pos].front().m_letters.data();
+    }
+
+    /**
+     * @brief All columns, e.g. for statesFromWord().
+     */
+    WordColumnPointers columnPointers() const;
+
+    /**
+     * @brief Bit ch of letterMasks()[idx] is set when word idx contains letter ch. Padded like the columns.
+     */
+    uint32_t const* letterMasks() const {
+        return m_letterMasks.data();
+    }
+
+    Word word(size_t idx) const;
+
+    /**
+     * @brief Indices of all words that satisfy the constraints, in increasing order.
+     *
+     * Uses the kernel for activeIsa(), which tests 16 (SSE4.2) to 64 (AVX-512) words per step.
+     */
+    std::vector<uint32_t> filter(Constraints const& constraints) const;
+};
+
+} // namespace wordle
@@ -0,0 +1,153 @@
+#include <wordle/FeedbackTable.h>
+#include <wordle/WordDatabase.h>
+
+#include <unistd.h>
+
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+
+namespace wordle {
+
+namespace {
+
+// Layout of the file: this header, followed by uint32_t arrays:
+//
+// allowed words [numAllowed], correct words [numCorrect], correctToAllowed [numCorrect]
+//
+// Everything is 4 byte aligned, so it can be used directly from the mapping.
+struct DatabaseHeader {
+    std::array<char, 8> m_magic{};
+    uint32_t m_version{};
+    uint32_t m_numAllowed{};
+    uint32_t m_numCorrect{};
+    uint32_t m_reserved{};
+    uint64_t m_contentHash{};
+};
+
+constexpr auto DatabaseMagic = std::array<char, 8>{'w', 'o', 'r', 'd', 'l', 'e', 'd', 'b'};
+constexpr auto NumLetters = size_t('z' - 'a' + 1);
+
+static_assert(sizeof(Word) == sizeof(uint32_t), "words are stored as their bits");
+static_assert(sizeof(DatabaseHeader) % sizeof(uint32_t) == 0);
+
+size_t fileSize(size_t numAllowed, size_t numCorrect) {
+    return sizeof(DatabaseHeader) + sizeof(uint32_t) * (numAllowed + 2 * numCorrect);
+}
+
+// All 5 letters are 0-25 and the unused high bits are zero, otherwise equal words would not compare equal
+bool isValidWord(Word word) {
+    if ((word.bits() >> (NumCharacters * Word::BitsPerLetter)) != 0) {
+        return false;
+    }
+    for (size_t i = 0; i < word.size(); ++i) {
+        if (static_cast<size_t>(word[i]) >= NumLetters) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+WordDatabase::WordDatabase(std::filesystem::path const& filename)
+    : m_mappedFile(filename) {
+    auto header = DatabaseHeader();
+    if (m_mappedFile.size() >= sizeof(header)) {
+        std::memcpy(&header, m_mappedFile.data(), sizeof(header));
+    }
+    if (header.m_magic != DatabaseMagic) {
+        throw std::runtime_error(filename.string() + " is not a word database");
+    }
+    if (header.m_version != Version) {
+        throw std::runtime_error(filename.string() + " has version " + std::to_string(header.m_version) + ", expected " +
+                                 std::to_string(Version) + ". Recreate it with wordle-pack");
+    }
+    if (m_mappedFile.size() != fileSize(header.m_numAllowed, header.m_numCorrect)) {
+        throw std::runtime_error(filename.string() + " has the wrong size");
+    }
+
+    auto const* data = reinterpret_cast<uint32_t const*>(m_mappedFile.data() + sizeof(header));
+    auto take = [&](size_t count) {
+        auto const* section = data;
+        data += count;
+        return section;
+    };
+
+    m_allowed.m_size = header.m_numAllowed;
+    m_correct.m_size = header.m_numCorrect;
+    m_allowed.m_words = reinterpret_cast<Word const*>(take(m_allowed.m_size));
+    m_correct.m_words = reinterpret_cast<Word const*>(take(m_correct.m_size));
+    m_correctToAllowed = take(m_correct.m_size);
+    m_contentHash = header.m_contentHash;
+
+    // the search indexes with these words and ids without any checks, so a corrupt file must not get through
+    for (auto const* list : {&m_allowed, &m_correct}) {
+        for (size_t idx = 0; idx < list->m_size; ++idx) {
+            if (!isValidWord(list->m_words[idx])) {
+                throw std::runtime_error(filename.string() + " has an invalid word");
+            }
+        }
+    }
+    for (size_t correctIdx = 0; correctIdx < m_correct.m_size; ++correctIdx) {
+        auto allowedIdx = m_correctToAllowed[correctIdx];
+        if (allowedIdx != NotAllowed &&
+            (allowedIdx >= m_allowed.m_size || m_allowed.m_words[allowedIdx] != m_correct.m_words[correctIdx])) {
+            throw std::runtime_error(filename.string() + " has an invalid index of correct word " +
+                                     std::to_string(correctIdx));
+        }
+    }
+}
+
+void WordDatabase::write(std::filesystem::path const& filename,
+                         std::vector<Word> const& allowedWords,
+                         std::vector<Word> const& correctWords) {
+    auto header = DatabaseHeader();
+    header.m_magic = DatabaseMagic;
+    header.m_version = Version;
+    header.m_numAllowed = static_cast<uint32_t>(allowedWords.size());
+    header.m_numCorrect = static_cast<uint32_t>(correctWords.size());
+    header.m_contentHash = FeedbackTable::contentHash(allowedWords, correctWords);
+
+    auto allowedIndices = std::unordered_map<uint32_t, uint32_t>();
+    for (size_t allowedIdx = 0; allowedIdx < allowedWords.size(); ++allowedIdx) {
+        allowedIndices.emplace(allowedWords[allowedIdx].bits(), static_cast<uint32_t>(allowedIdx));
+    }
+    auto correctToAllowed = std::vector<uint32_t>();
+    for (auto const& word : correctWords) {
+        auto it = allowedIndices.find(word.bits());
+        correctToAllowed.push_back(it == allowedIndices.end() ? NotAllowed : it->second);
+    }
+
+    // Write to a temporary file first, then rename. That's atomic, so other processes never map a half written file.
+    auto tmpFile = filename;
+    tmpFile += ".tmp" + std::to_string(::getpid());
+    {
+        auto fout = std::ofstream(tmpFile, std::ios::binary);
+        auto put = [&](void const* data, size_t numBytes) {
+            fout.write(static_cast<char const*>(data), static_cast<std::streamsize>(numBytes));
+        };
+        put(&header, sizeof(header));
+        put(allowedWords.data(), allowedWords.size() * sizeof(Word));
+        put(correctWords.data(), correctWords.size() * sizeof(Word));
+        put(correctToAllowed.data(), correctToAllowed.size() * sizeof(uint32_t));
+        if (!fout) {
+            auto ec = std::error_code();
+            std::filesystem::remove(tmpFile, ec);
+            throw std::runtime_error("Could not write " + tmpFile.string());
+        }
+    }
+
+    auto ec = std::error_code();
+    std::filesystem::rename(tmpFile, filename, ec);
+    if (ec) {
+        std::filesystem::remove(tmpFile, ec);
+        throw std::runtime_error("Could not write " + filename.string());
+    }
+}
+
+} // namespace wordle
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <wordle/MappedFile.h>
+#include <wordle/Word.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <vector>
+
+namespace wordle {
+
+/**
+ * @brief Allowed and correct words of a dictionary in a binary file (.wdb), ready to use without any parsing or sorting.
+ *
+ * The words are stored in the order the search uses (see readWordLists()), together with the position of each correct
+ * word in the allowed words and the content hash that keys the feedback cache. wordle-pack creates the file from the text
+ * dictionaries.
+ *
+ * The whole file is memory mapped, all data is used directly from the mapping. Words and positions are validated when
+ * the file is opened.
+ */
+class WordDatabase {
+public:
+    // One list of words, the pointer points into the mapped file.
+    struct WordList {
+        Word const* m_words{};
+        size_t m_size{};
+
+        std::vector<Word> toVector() const {
+            return std::vector<Word>(m_words, m_words + m_size);
+        }
+    };
+
+    // correctToAllowed() of a correct word that is not an allowed word
+    static constexpr uint32_t NotAllowed = std::numeric_limits<uint32_t>::max();
+
+    // increment whenever the file layout changes
+    static constexpr uint32_t Version = 2;
+
+    /**
+     * @brief Maps the file, throws std::runtime_error when it can't be read or is not a valid database: wrong magic, version
+     * or size, a letter that's not 0-25, or a correct word whose index in the allowed words is out of range or points to
+     * a different word.
+     */
+    explicit WordDatabase(std::filesystem::path const& filename);
+
+    /**
+     * @brief Writes a database for the words, in this order. The file is replaced atomically, throws std::runtime_error
+     * when that's not possible.
+     */
+    static void write(std::filesystem::path const& filename,
+                      std::vector<Word> const& allowedWords,
+                      std::vector<Word> const& correctWords);
+
+    WordList const& allowed() const {
+        return m_allowed;
+    }
+
+    WordList const& correct() const {
+        return m_correct;
+    }
+
+    /**
+     * @brief Index of correct word correctIdx in the allowed words, or NotAllowed.
+     */
+    uint32_t correctToAllowed(size_t correctIdx) const {
+        return m_correctToAllowed[correctIdx];
+    }
+
+    /**
+     * @brief Same as FeedbackTable::contentHash() of the allowed and correct words.
+     */
+    uint64_t contentHash() const {
+        return m_contentHash;
+    }
+
+private:
+    MappedFile m_mappedFile;
+    WordList m_allowed{};
+    WordList m_correct{};
+    uint32_t const* m_correctToAllowed{};
+    uint64_t m_contentHash{};
+};
+
+} // namespace wordle
@@ -0,0 +1,100 @@
+#include <wordle/AlphabetMap.h>
+#include <wordle/WordIndex.h>
+
+#include <algorithm>
+
+namespace wordle {
+
+namespace {
+
+void andBits(std::vector<uint64_t>& result, uint64_t const* bits) {
+    for (size_t i = 0; i < result.size(); ++i) {
+        result[i] &= bits[i];
+    }
+}
+
+void andNotBits(std::vector<uint64_t>& result, uint64_t const* bits) {
+    for (size_t i = 0; i < result.size(); ++i) {
+        result[i] &= ~bits[i];
+    }
+}
+
+void orBits(std::vector<uint64_t>& result, uint64_t const* bits) {
+    for (size_t i = 0; i < result.size(); ++i) {
+        result[i] |= bits[i];
+    }
+}
+
+} // namespace
+
+WordIndex::WordIndex(std::vector<Word> const& words)
+    : m_size(words.size())
+    , m_numBlocks((words.size() + 63) / 64)
+    , m_bitsets((NumCharacters * NumLetters + NumLetters * NumCharacters) * m_numBlocks) {
+    for (size_t idx = 0; idx < words.size(); ++idx) {
+        auto const& word = words[idx];
+        auto block = idx / 64;
+        auto bit = uint64_t(1) << (idx % 64);
+
+        // the n-th occurrence of a letter sets the word's bit in atLeast(ch, n), so together they set 1..count
+        auto counts = AlphabetMap<size_t>();
+        for (size_t pos = 0; pos < NumCharacters; ++pos) {
+            auto ch = word[pos];
+            m_bitsets[(pos * NumLetters + static_cast<size_t>(ch)) * m_numBlocks + block] |= bit;
+            m_bitsets[(NumCharacters * NumLetters + static_cast<size_t>(ch) * NumCharacters + counts[ch]) * m_numBlocks +
+                      block] |= bit;
+            ++counts[ch];
+            m_presentLetters[pos] |= uint32_t(1) << static_cast<uint32_t>(ch);
+        }
+    }
+}
+
+std::vector<uint32_t> WordIndex::query(Constraints const& constraints) const {
+    auto indices = std::vector<uint32_t>();
+    if (!constraints.isSatisfiable() || m_size == 0) {
+        return indices;
+    }
+
+    auto result = std::vector<uint64_t>(m_numBlocks, ~uint64_t());
+    if (m_size % 64 != 0) {
+        result.back() = (uint64_t(1) << (m_size % 64)) - 1;
+    }
+
+    // For each position either keep the allowed letters or remove the forbidden ones, whatever needs fewer bitsets.
+    auto allowedAny = std::vector<uint64_t>(m_numBlocks);
+    for (size_t pos = 0; pos < NumCharacters; ++pos) {
+        auto allowed = constraints.allowedLetters(pos) & m_presentLetters[pos];
+        auto forbidden = ~constraints.allowedLetters(pos) & m_presentLetters[pos];
+        if (__builtin_popcount(allowed) <= __builtin_popcount(forbidden)) {
+            std::fill(allowedAny.begin(), allowedAny.end(), uint64_t());
+            for (; allowed != 0; allowed &= allowed - 1) {
+                orBits(allowedAny, letterAt(pos, static_cast<char>(__builtin_ctz(allowed))));
+            }
+            andBits(result, allowedAny.data());
+        } else {
+            for (; forbidden != 0; forbidden &= forbidden - 1) {
+                andNotBits(result, letterAt(pos, static_cast<char>(__builtin_ctz(forbidden))));
+            }
+        }
+    }
+
+    for (char ch = 0; ch < static_cast<char>(NumLetters); ++ch) {
+        auto minCount = constraints.minCount(ch);
+        if (minCount != 0) {
+            andBits(result, atLeast(ch, minCount));
+        }
+        auto maxCount = constraints.maxCount(ch);
+        if (maxCount < NumCharacters) {
+            andNotBits(result, atLeast(ch, maxCount + 1U));
+        }
+    }
+
+    for (size_t i = 0; i < m_numBlocks; ++i) {
+        for (auto block = result[i]; block != 0; block &= block - 1) {
+            indices.push_back(static_cast<uint32_t>(i * 64 + static_cast<size_t>(__builtin_ctzll(block))));
+        }
+    }
+    return indices;
+}
+
+} // namespace wordle
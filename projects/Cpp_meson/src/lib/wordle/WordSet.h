@@ -0,0 +1,141 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace wordle {
+
+/**
+ * @brief Set of correct words, stored as a fixed size bitset of word indices.
+ *
+ * The size is fixed so a set is a plain value that lives on the stack and never allocates. 37 * 64 = 2368 bits is enough for
+ * all dictionaries we have (english has 2315 correct words). Intersection is an AND, size is a popcount.
+ */
+class WordSet {
+public:
+    static constexpr size_t NumBlocks = 37;
+    static constexpr size_t MaxWords = NumBlocks * 64;
+
+private:
+    std::array<uint64_t, NumBlocks> m_blocks{};
+
+public:
+    constexpr void insert(size_t idx) {
+        m_blocks[idx / 64] |= uint64_t(1) << (idx % 64);
+    }
+
+    constexpr void erase(size_t idx) {
+        m_blocks[idx / 64] &= ~(uint64_t(1) << (idx % 64));
+    }
+
+    constexpr bool contains(size_t idx) const {
+        return 0 != (m_blocks[idx / 64] & (uint64_t(1) << (idx % 64)));
+    }
+
+    /**
+     * @brief Number of words in the set.
+     */
+    size_t size() const {
+        auto s = size_t();
+        for (auto block : m_blocks) {
+            s += static_cast<size_t>(__builtin_popcountll(block));
+        }
+        return s;
+    }
+
+    /**
+     * @brief Number of words that are in both sets, same as (*this & other).size() but without the temporary.
+     */
+    size_t intersectionSize(WordSet const& other) const {
+        auto s = size_t();
+        for (size_t i = 0; i < NumBlocks; ++i) {
+            s += static_cast<size_t>(__builtin_popcountll(m_blocks[i] & other.m_blocks[i]));
+        }
+        return s;
+    }
+
+    constexpr bool empty() const {
+        for (auto block : m_blocks) {
+            if (block != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    constexpr WordSet& operator&=(WordSet const& other) {
+        for (size_t i = 0; i < NumBlocks; ++i) {
+            m_blocks[i] &= other.m_blocks[i];
+        }
+        return *this;
+    }
+
+    constexpr WordSet& operator|=(WordSet const& other) {
+        for (size_t i = 0; i < NumBlocks; ++i) {
+            m_blocks[i] |= other.m_blocks[i];
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Calls op(idx) for each word index in the set, in increasing order.
+     */
+    template <typename Op>
+    void forEach(Op&& op) const {
+        for (size_t i = 0; i < NumBlocks; ++i) {
+            auto block = m_blocks[i];
+            while (block != 0) {
+                op(i * 64 + static_cast<size_t>(__builtin_ctzll(block)));
+                // clear lowest set bit
+                block &= block - 1;
+            }
+        }
+    }
+
+    /**
+     * @brief Random looking 64 bit key of a single word index (splitmix64).
+     */
+    static constexpr uint64_t wordKey(size_t idx) {
+        auto z = static_cast<uint64_t>(idx + 1) * UINT64_C(0x9e3779b97f4a7c15);
+        z = (z ^ (z >> 30)) * UINT64_C(0xbf58476d1ce4e5b9);
+        z = (z ^ (z >> 27)) * UINT64_C(0x94d049bb133111eb);
+        return z ^ (z >> 31);
+    }
+
+    /**
+     * @brief Zobrist hash: XOR of wordKey() of all words in the set.
+     *
+     * Since it's an XOR, it can be updated incrementally when words are inserted or erased.
+     */
+    uint64_t hash() const {
+        auto h = uint64_t();
+        forEach([&](size_t idx) {
+            h ^= wordKey(idx);
+        });
+        return h;
+    }
+
+    constexpr bool operator==(WordSet const& other) const {
+        for (size_t i = 0; i < NumBlocks; ++i) {
+            if (m_blocks[i] != other.m_blocks[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    constexpr bool operator!=(WordSet const& other) const {
+        return !(*this == other);
+    }
+};
+
+constexpr WordSet operator&(WordSet a, WordSet const& b) {
+    return a &= b;
+}
+
+constexpr WordSet operator|(WordSet a, WordSet const& b) {
+    return a |= b;
+}
+
+} // namespace wordle
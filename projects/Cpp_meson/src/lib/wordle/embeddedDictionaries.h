@@ -0,0 +1,47 @@
+#pragma once
+
+#include <wordle/Word.h>
+
+#include <cstddef>
+#include <string_view>
+
+namespace wordle {
+
+/**
+ * @brief Dictionary that is compiled into the binary, see the embed_dictionaries build option.
+ *
+ * wordle-embed generates the arrays at build time with readWordLists(), so the words are already in the order the search
+ * uses.
+ */
+struct EmbeddedDictionary {
+    std::string_view m_name;
+    Word const* m_allowedWords;
+    size_t m_numAllowed;
+    Word const* m_correctWords;
+    size_t m_numCorrect;
+};
+
+/**
+ * @brief All embedded dictionaries. Empty unless the binary was built with -Dembed_dictionaries=true.
+ */
+struct EmbeddedDictionaries {
+    EmbeddedDictionary const* m_dictionaries;
+    size_t m_size;
+};
+
+EmbeddedDictionaries embeddedDictionaries();
+
+/**
+ * @brief The embedded dictionary with this name, or nullptr.
+ */
+inline EmbeddedDictionary const* findEmbeddedDictionary(std::string_view name) {
+    auto dictionaries = embeddedDictionaries();
+    for (size_t i = 0; i < dictionaries.m_size; ++i) {
+        if (dictionaries.m_dictionaries[i].m_name == name) {
+            return dictionaries.m_dictionaries + i;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace wordle
@@ -0,0 +1,10 @@
+#include <wordle/embeddedDictionaries.h>
+
+namespace wordle {
+
+// Used when the build doesn't embed any dictionaries, wordle-embed generates the replacement.
+EmbeddedDictionaries embeddedDictionaries() {
+    return {nullptr, 0};
+}
+
+} // namespace wordle
@@ -1,71 +1,134 @@
+#include <wordle/MappedFile.h>
 #include <wordle/parseDict.h>
 
+#include <array>
 #include <istream>
-#include <unordered_set>
+#include <iterator>
+#include <string>
 #include <vector>
 
 namespace wordle {
 
 namespace {
 
+// Character classes for the scanner. Letters map to 0-25 for both cases, so they can be packed into a Word directly.
+constexpr auto Space = uint8_t(0x40);
+constexpr auto Invalid = uint8_t(0x80);
+
 /**
- * @brief Uppercase to lowercase conversion map A..Z -> a..z.
- *
- * Invalid characters are mapped to 0.
+ * @brief Maps every byte to its letter 0-25, Space for the whitespace that std::istream uses as a separator, and Invalid
+ * for everything else.
  */
-constexpr auto createUpperToLowercaseTable() -> std::array<char, 256> {
-    auto data = std::array<char, 256>{}; // 0-initialize
+constexpr auto createCharacterClassTable() -> std::array<uint8_t, 256> {
+    auto data = std::array<uint8_t, 256>{};
+    for (auto& cls : data) {
+        cls = Invalid;
+    }
+    for (auto ch : {' ', '\t', '\n', '\v', '\f', '\r'}) {
+        data[static_cast<uint8_t>(ch)] = Space;
+    }
     for (auto ch = 'a'; ch != 'z' + 1; ++ch) {
-        data[ch] = ch;
-        data[ch + 'A' - 'a'] = ch;
+        data[static_cast<uint8_t>(ch)] = static_cast<uint8_t>(ch - 'a');
+        data[static_cast<uint8_t>(ch + 'A' - 'a')] = static_cast<uint8_t>(ch - 'a');
     }
     return data;
 }
 
+constexpr auto CharacterClasses = createCharacterClassTable();
+
+/**
+ * @brief One bit for each of the 2^25 possible packed words, 4 MB. Much cheaper than hashing strings.
+ */
+class WordBitmap {
+    std::vector<uint64_t> m_bits = std::vector<uint64_t>((size_t(1) << (NumCharacters * Word::BitsPerLetter)) / 64);
+
+public:
+    // Sets the word's bit, returns true if it was not yet set.
+    bool insert(Word const& word) {
+        auto& block = m_bits[word.bits() / 64];
+        auto mask = uint64_t(1) << (word.bits() % 64);
+        auto isNew = (block & mask) == 0;
+        block |= mask;
+        return isNew;
+    }
+};
+
 } // namespace
 
-std::vector<Word> parseDict(std::istream& in) {
-    auto word = std::string();
+std::vector<Word> parseDict(std::string_view text) {
     auto words = std::vector<Word>();
-    auto uniqueWords = std::unordered_set<std::string>();
-    while (in >> word) {
-        if (word.size() != NumCharacters) {
-            continue;
-        }
+    auto uniqueWords = WordBitmap();
+
+    auto const* it = reinterpret_cast<uint8_t const*>(text.data());
+    auto const* end = it + text.size();
 
-        bool allLettersValid = true;
-        for (auto& ch : word) {
-            constexpr auto map = createUpperToLowercaseTable();
-            ch = map[ch];
-            if (ch == 0) {
-                allLettersValid = false;
+    while (it != end) {
+        // Fast path for the usual dictionary line: 5 letters followed by a separator. The classes of all 6 bytes are
+        // combined without branching, so there's a single check per word.
+        if (end - it > NumCharacters) {
+            auto bits = uint32_t();
+            auto flags = uint8_t();
+            for (size_t i = 0; i < NumCharacters; ++i) {
+                auto cls = CharacterClasses[it[i]];
+                flags |= cls;
+                bits |= static_cast<uint32_t>(cls & Word::LetterMask) << (i * Word::BitsPerLetter);
+            }
+            if (flags < Space && CharacterClasses[it[NumCharacters]] == Space) {
+                auto word = Word::fromBits(bits);
+                if (uniqueWords.insert(word)) {
+                    words.push_back(word);
+                }
+                it += NumCharacters + 1;
                 continue;
             }
         }
 
-        if (!allLettersValid) {
+        // Slow path: skip separators, then walk over the whole token.
+        if (CharacterClasses[*it] == Space) {
+            ++it;
             continue;
         }
-        if (uniqueWords.emplace(word).second) {
-            Word w{};
-            for (size_t i = 0; i < word.size(); ++i) {
-                w[i] = word[i] - 'a';
+        auto bits = uint32_t();
+        auto flags = uint8_t();
+        size_t size = 0;
+        for (; it != end && CharacterClasses[*it] != Space; ++it, ++size) {
+            auto cls = CharacterClasses[*it];
+            flags |= cls;
+            if (size < NumCharacters) {
+                bits |= static_cast<uint32_t>(cls & Word::LetterMask) << (size * Word::BitsPerLetter);
+            }
+        }
+        if (size == NumCharacters && flags < Space) {
+            auto word = Word::fromBits(bits);
+            if (uniqueWords.insert(word)) {
+                words.push_back(word);
             }
-            words.push_back(w);
         }
     }
 
     return words;
 }
 
+std::vector<Word> parseDict(std::istream& in) {
+    auto text = std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    return parseDict(std::string_view(text));
+}
+
+std::vector<Word> parseDictFile(std::filesystem::path const& filename) {
+    auto mappedFile = MappedFile(filename);
+    return parseDict(std::string_view(reinterpret_cast<char const*>(mappedFile.data()), mappedFile.size()));
+}
+
 } // namespace wordle
 
 namespace wordle::test {
 
-static_assert(createUpperToLowercaseTable()['a'] == 'a');
-static_assert(createUpperToLowercaseTable()['z'] == 'z');
-static_assert(createUpperToLowercaseTable()['A'] == 'a');
-static_assert(createUpperToLowercaseTable()['Z'] == 'z');
-static_assert(createUpperToLowercaseTable()['1'] == 0);
+static_assert(CharacterClasses['a'] == 0);
+static_assert(CharacterClasses['z'] == 25);
+static_assert(CharacterClasses['A'] == 0);
+static_assert(CharacterClasses['Z'] == 25);
+static_assert(CharacterClasses['\n'] == Space);
+static_assert(CharacterClasses['1'] == Invalid);
+static_assert(CharacterClasses[0xc3] == Invalid);
 
 } // namespace wordle::test
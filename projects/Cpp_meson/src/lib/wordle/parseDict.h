@@ -2,12 +2,23 @@
 
 #include <wordle/Word.h>
 
+#include <filesystem>
 #include <iosfwd>
+#include <string_view>
 #include <vector>
 
 namespace wordle {
 
 // Parses a dictionary, extracting words.
+//
+// Words are separated by whitespace. Only words with exactly 5 letters a-z or A-Z are used, in the order of their first
+// occurrence. Duplicates are skipped.
+std::vector<Word> parseDict(std::string_view text);
+
+// Reads the whole stream, and parses it like above.
 std::vector<Word> parseDict(std::istream& in);
 
+// Memory maps the file and parses it like above. Throws std::runtime_error when the file can't be opened.
+std::vector<Word> parseDictFile(std::filesystem::path const& filename);
+
 } // namespace wordle
@@ -0,0 +1,53 @@
+#include <wordle/parsePattern.h>
+
+#include <stdexcept>
+#include <string>
+
+namespace wordle {
+
+namespace {
+
+char toLetter(char ch, std::string_view part) {
+    if (ch < 'a' || ch > 'z') {
+        throw std::runtime_error("invalid letter '" + std::string(1, ch) + "' in pattern part '" + std::string(part) + "'");
+    }
+    return static_cast<char>(ch - 'a');
+}
+
+} // namespace
+
+Constraints parsePattern(std::string_view pattern) {
+    auto constraints = Constraints();
+    while (!pattern.empty()) {
+        auto begin = pattern.find_first_not_of(' ');
+        if (begin == std::string_view::npos) {
+            break;
+        }
+        pattern.remove_prefix(begin);
+        auto part = pattern.substr(0, pattern.find(' '));
+        pattern.remove_prefix(part.size());
+
+        if (part[0] == '+') {
+            auto counts = AlphabetMap<uint8_t>();
+            for (auto ch : part.substr(1)) {
+                auto letter = toLetter(ch, part);
+                constraints.addMinCount(letter, ++counts[letter]);
+            }
+        } else if (part[0] == '-') {
+            for (auto ch : part.substr(1)) {
+                constraints.addMaxCount(toLetter(ch, part), 0);
+            }
+        } else if (part.size() == NumCharacters) {
+            for (size_t i = 0; i < NumCharacters; ++i) {
+                if (part[i] != '?') {
+                    constraints.addLetterAt(i, toLetter(part[i], part));
+                }
+            }
+        } else {
+            throw std::runtime_error("invalid pattern part '" + std::string(part) + "'");
+        }
+    }
+    return constraints;
+}
+
+} // namespace wordle
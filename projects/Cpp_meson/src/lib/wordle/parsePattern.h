@@ -0,0 +1,21 @@
+#pragma once
+
+#include <wordle/Constraints.h>
+
+#include <string_view>
+
+namespace wordle {
+
+/**
+ * @brief Parses a query like "?a??e +r -st" into constraints.
+ *
+ * Space separated parts, in any order:
+ * - 5 characters, each a letter that has to be at that position or '?' for any letter, e.g. "?a??e".
+ * - '+' followed by letters the word has to contain. A repeated letter has to be in the word that often, e.g. "+rr".
+ * - '-' followed by letters the word must not contain, e.g. "-st".
+ *
+ * Throws std::runtime_error for anything else.
+ */
+Constraints parsePattern(std::string_view pattern);
+
+} // namespace wordle
@@ -0,0 +1,90 @@
+#include <util/parallel/for_each.h>
+#include <wordle/runBatch.h>
+
+#include <istream>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+namespace wordle {
+
+BatchStats runBatch(Dictionary const& dict,
+                    std::istream& in,
+                    std::ostream& out,
+                    size_t maxDepth,
+                    std::optional<std::chrono::milliseconds> timeBudget) {
+    static constexpr size_t ChunkSize = 256;
+
+    struct WordSetHash {
+        size_t operator()(WordSet const& words) const {
+            return static_cast<size_t>(words.hash());
+        }
+    };
+    auto answers = std::unordered_map<WordSet, std::string, WordSetHash>();
+
+    // Tables are cleared for each depth of each search, so they are small enough that this is cheap for the typical few
+    // remaining words.
+    auto tables = TranspositionTablePool(1U << 14U);
+
+    auto numLines = size_t();
+    auto lineAnswers = std::vector<std::variant<WordSet, std::string>>();
+    auto todo = std::vector<WordSet>();
+    auto line = std::string();
+    while (in) {
+        lineAnswers.clear();
+        todo.clear();
+        while (lineAnswers.size() < ChunkSize && std::getline(in, line)) {
+            try {
+                if (auto queryAnswer = answerQuery(dict, line)) {
+                    lineAnswers.emplace_back(std::move(*queryAnswer));
+                    continue;
+                }
+                auto lineStream = std::istringstream(line);
+                auto remainingCorrectWords = filterCorrectWords(dict, parseClues(lineStream));
+                if (remainingCorrectWords.empty()) {
+                    throw std::runtime_error("no correct word matches the clues");
+                }
+                if (answers.emplace(remainingCorrectWords, std::string()).second) {
+                    todo.push_back(remainingCorrectWords);
+                }
+                lineAnswers.emplace_back(remainingCorrectWords);
+            } catch (std::exception const& e) {
+                lineAnswers.emplace_back(std::string("error: ") + e.what());
+            }
+        }
+
+        auto results = std::vector<std::string>(todo.size());
+        ankerl::parallel::for_each(todo.begin(), todo.end(), [&](WordSet const& remainingCorrectWords) {
+            auto table = tables.acquire();
+            auto deadline = std::optional<std::chrono::steady_clock::time_point>();
+            if (timeBudget) {
+                deadline = std::chrono::steady_clock::now() + *timeBudget;
+            }
+            auto result = solve(dict, remainingCorrectWords, *table, maxDepth, deadline, false, false);
+            auto os = std::ostringstream();
+            os << result.m_fitness << " " << dict.word(result.m_guessId);
+            results[static_cast<size_t>(&remainingCorrectWords - todo.data())] = os.str();
+            tables.release(std::move(table));
+        });
+        for (size_t i = 0; i < todo.size(); ++i) {
+            answers[todo[i]] = std::move(results[i]);
+        }
+
+        for (auto const& lineAnswer : lineAnswers) {
+            if (auto const* remainingCorrectWords = std::get_if<WordSet>(&lineAnswer)) {
+                out << answers[*remainingCorrectWords] << '\n';
+            } else {
+                out << std::get<std::string>(lineAnswer) << '\n';
+            }
+        }
+        out.flush();
+        numLines += lineAnswers.size();
+    }
+    return {numLines, answers.size()};
+}
+
+} // namespace wordle
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <wordle/solve.h>
+
+#include <chrono>
+#include <cstddef>
+#include <iosfwd>
+#include <optional>
+
+namespace wordle {
+
+struct BatchStats {
+    size_t m_numLines{};
+
+    // number of different sets of remaining correct words, each was solved once
+    size_t m_numUnique{};
+};
+
+/**
+ * @brief Answers each line of in, a list of word-state clues, with one line "<fitness> <guess>" or "error: <message>".
+ *
+ * The best guess only depends on the remaining correct words, so lines are deduplicated by that set, also across chunks.
+ * Lines are processed in chunks: the new sets of a chunk are solved in parallel, one single threaded search per set, each
+ * with its own small transposition table. Then the answers of the chunk are written in input order. A line that can't be
+ * parsed only gets an error answer, all others are still solved. Lines that start with "query" are answered with
+ * answerQuery().
+ */
+BatchStats runBatch(Dictionary const& dict,
+                    std::istream& in,
+                    std::ostream& out,
+                    size_t maxDepth,
+                    std::optional<std::chrono::milliseconds> timeBudget);
+
+} // namespace wordle
@@ -0,0 +1,976 @@
+#include <util/parallel/for_each.h>
+#include <wordle/AlphabetMap.h>
+#include <wordle/WordDatabase.h>
+#include <wordle/embeddedDictionaries.h>
+#include <wordle/parseDict.h>
+#include <wordle/parsePattern.h>
+#include <wordle/solve.h>
+
+#include <atomic>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace wordle {
+
+namespace {
+
+enum class Player : bool { maxi, mini };
+
+/**
+ * @brief Turns what is known about a value, lower <= value <= upper, into a Result with the most useful bound for the
+ * window [alpha, beta].
+ *
+ * Each of the three bounds is correct by itself, so this works no matter how the window changed while searching. But which
+ * one is the most useful depends on the window, so pass the one the enclosing loops have now, not the one the node started
+ * with. Otherwise a node that was cut off by a bound of another thread would keep the side that doesn't matter any more.
+ */
+Result toResult(Player player, Fitness const& lower, Fitness const& upper, Fitness const& alpha, Fitness const& beta) {
+    if (lower == upper) {
+        return {upper, NoWordId, Bound::exact};
+    }
+    if (upper <= alpha) {
+        return {upper, NoWordId, Bound::upper};
+    }
+    if (lower >= beta) {
+        return {lower, NoWordId, Bound::lower};
+    }
+    // only possible when bounds of other threads have changed the window. Keep what the player has achieved.
+    if (player == Player::mini) {
+        return {upper, NoWordId, Bound::upper};
+    }
+    return {lower, NoWordId, Bound::lower};
+}
+
+static_assert(WordSet::MaxWords < Fitness::PackedMax, "counts must fit into the packed representation");
+static_assert(Fitness::MaxDepth * Fitness::PackedBits + 16 <= 64, "packed fitness and guess index must fit into 64 bit");
+
+/**
+ * @brief Results of a parallel loop in mini() or maxi(), shared lock free by all threads that work on it.
+ *
+ * The best fitness is the beta (for mini) or alpha (for maxi) of everything below, so all nodes poll it and prune with
+ * whatever any thread has found so far. Nested parallel loops chain to the enclosing one, so the tightest bounds of all of
+ * them are used.
+ */
+class SharedBest {
+    Player m_player;
+
+    // Packed fitness in the upper bits, guess index in the lowest 16 bits. Same fitness prefers the lower index for mini.
+    // This is the upper limit for mini, and the lower limit for maxi.
+    std::atomic<uint64_t> m_best;
+
+    // packed limit on the other side
+    std::atomic<uint64_t> m_other;
+
+    std::atomic<bool> m_isComplete{true};
+    SharedBest const* m_parent;
+
+    static constexpr uint64_t NoGuess = 0xffff;
+
+    static bool atomicMin(std::atomic<uint64_t>& atomic, uint64_t value) {
+        auto current = atomic.load(std::memory_order_relaxed);
+        while (value < current) {
+            if (atomic.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static bool atomicMax(std::atomic<uint64_t>& atomic, uint64_t value) {
+        auto current = atomic.load(std::memory_order_relaxed);
+        while (value > current) {
+            if (atomic.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+public:
+    static constexpr size_t MaxGuesses = NoGuess;
+
+    SharedBest(Player player, SharedBest const* parent)
+        : m_player(player)
+        , m_best(player == Player::mini ? (Fitness::maxi().pack() << 16U) | NoGuess : 0)
+        , m_other(player == Player::mini ? Fitness::maxi().pack() : 0)
+        , m_parent(parent) {}
+
+    /**
+     * @brief Adds the result of child idx.
+     *
+     * @return true if it is the new best.
+     */
+    bool update(Result const& value, size_t idx) {
+        if (m_player == Player::mini) {
+            atomicMin(m_other, value.lowerLimit().pack());
+            return atomicMin(m_best, (value.upperLimit().pack() << 16U) | idx);
+        }
+        atomicMax(m_other, value.upperLimit().pack());
+        return atomicMax(m_best, (value.lowerLimit().pack() << 16U) | idx);
+    }
+
+    /**
+     * @brief Marks that not all children will be searched.
+     */
+    void stop() {
+        m_isComplete = false;
+    }
+
+    Fitness best() const {
+        return Fitness::unpack(m_best.load(std::memory_order_relaxed) >> 16U);
+    }
+
+    /**
+     * @brief Index of the best child, or std::nullopt if there is none.
+     */
+    std::optional<size_t> bestIdx() const {
+        auto idx = m_best.load(std::memory_order_relaxed) & NoGuess;
+        if (idx == NoGuess) {
+            return std::nullopt;
+        }
+        return idx;
+    }
+
+    /**
+     * @brief Combines the results of all children. Call when all threads are finished.
+     *
+     * alpha and beta are the window the loop started with, the bounds of the enclosing loops narrow it to the current one.
+     */
+    Result result(Fitness alpha, Fitness beta) const {
+        if (m_parent != nullptr) {
+            m_parent->tighten(alpha, beta);
+        }
+        auto other = Fitness::unpack(m_other);
+        if (m_player == Player::mini) {
+            return toResult(m_player, m_isComplete ? other : Fitness::mini(), best(), alpha, beta);
+        }
+        return toResult(m_player, best(), m_isComplete ? other : Fitness::maxi(), alpha, beta);
+    }
+
+    /**
+     * @brief Narrows the window to the tightest bounds of this and all enclosing loops.
+     */
+    void tighten(Fitness& alpha, Fitness& beta) const {
+        for (auto const* shared = this; shared != nullptr; shared = shared->m_parent) {
+            if (shared->m_player == Player::mini) {
+                beta = std::min(beta, shared->best());
+            } else {
+                alpha = std::max(alpha, shared->best());
+            }
+        }
+    }
+};
+
+/**
+ * @brief Thrown when the search runs out of time.
+ */
+class DeadlineReached : public std::runtime_error {
+public:
+    DeadlineReached()
+        : std::runtime_error("deadline reached") {}
+};
+
+/**
+ * @brief All the data that stays constant during the search.
+ *
+ * Words are referenced by their index: guess words by their WordId, correct words by their index into m_correctIds. That
+ * way the state of any pair can be looked up in m_feedback. m_transpositions is shared by all threads.
+ */
+struct SearchData {
+    std::vector<Word> const* m_allowedWords;
+    std::vector<WordId> const* m_correctIds;
+    FeedbackTable const* m_feedback;
+    FeedbackMasks const* m_masks;
+    TranspositionTable<Result>* m_transpositions;
+
+    // mini() loops over all guesses in parallel for all depths below this, maxi() over all buckets. They run on m_pool.
+    size_t m_parallelMiniDepth;
+    size_t m_parallelMaxiDepth;
+    ankerl::parallel::ThreadPool* m_pool;
+
+    // Order in which mini() tries the guesses. The best ones should come first, so the cutoffs come early.
+    std::vector<WordId> const* m_guessOrder;
+
+    // receives the value of each guess at the root, indexed by guess
+    std::vector<Fitness>* m_rootValues;
+
+    // when set, the search throws DeadlineReached once this is over
+    std::optional<std::chrono::steady_clock::time_point> m_deadline;
+
+    // prints each improvement at the root, and the result of each depth
+    bool m_isVerbose = true;
+
+    void checkDeadline() const {
+        if (m_deadline && std::chrono::steady_clock::now() > *m_deadline) {
+            throw DeadlineReached();
+        }
+    }
+};
+
+/**
+ * @brief Contiguous range of correct word indices.
+ *
+ * maxi() sorts the words of its node by bucket, and each child gets its bucket as a slice of that. So the words of a node are
+ * never copied into a container of their own.
+ */
+class WordSlice {
+    uint16_t const* m_begin;
+    uint16_t const* m_end;
+
+public:
+    WordSlice(uint16_t const* begin, uint16_t const* end)
+        : m_begin(begin)
+        , m_end(end) {}
+
+    uint16_t const* begin() const {
+        return m_begin;
+    }
+
+    uint16_t const* end() const {
+        return m_end;
+    }
+
+    size_t size() const {
+        return static_cast<size_t>(m_end - m_begin);
+    }
+
+    uint16_t front() const {
+        return *m_begin;
+    }
+};
+
+namespace alphabeta {
+
+// see https://en.wikipedia.org/wiki/Alpha%E2%80%93beta_pruning#Pseudocode
+//
+// path holds the bucket sizes of all levels above currentDepth. All values of a subtree share them, and since they are part
+// of the value, comparisons against alpha and beta from further up are only correct with them in place.
+//
+// remainingSet holds the same words as remainingWords when mini() found the node dense enough for the FeedbackMasks, else
+// it's nullptr. Only the leaves use it.
+//
+// shared is the innermost parallel loop above this node, or nullptr. Its bounds can tighten at any time while we search, so
+// the window is polled at every node. When it closes, the node stops and returns whatever bound it has found so far.
+
+Result maxi(SearchData const& data,
+            WordSlice remainingWords,
+            WordSet const* remainingSet,
+            size_t guessIdx,
+            Fitness const& path,
+            size_t currentDepth,
+            size_t maxDepth,
+            Fitness alpha,
+            Fitness beta,
+            SharedBest const* shared);
+
+Result mini(SearchData const& data,
+            WordSlice remainingWords,
+            Fitness const& path,
+            size_t currentDepth,
+            size_t maxDepth,
+            Fitness alpha,
+            Fitness beta,
+            SharedBest const* shared);
+
+// Young brothers wait: the first item is processed alone, so it can establish a bound. Only then the others run in parallel.
+template <typename It, typename Op>
+void forEachYoungBrothersWait(It begin, It end, Op&& op, ankerl::parallel::ThreadPool& pool) {
+    if (begin != end && op(*begin) == ankerl::parallel::Continue::yes) {
+        ankerl::parallel::for_each(std::next(begin), end, op, pool);
+    }
+}
+
+// mini: wants to make a guess that lowers the number of remaining correct words as much as possible
+Result mini(SearchData const& data,
+            WordSlice remainingWords,
+            Fitness const& path,
+            size_t currentDepth,
+            size_t maxDepth,
+            Fitness alpha,
+            Fitness beta,
+            SharedBest const* shared) {
+    // same key as WordSet::hash(), it doesn't depend on the order of the words
+    auto key = uint64_t();
+    for (auto correctIdx : remainingWords) {
+        key ^= WordSet::wordKey(correctIdx);
+    }
+
+    if (remainingWords.size() == 1) {
+        // solved: no words remain from this level on
+        auto value = Result{path, (*data.m_correctIds)[remainingWords.front()]};
+        for (auto i = currentDepth; i < value.m_fitness.size(); ++i) {
+            value.m_fitness[i] = 0;
+        }
+        return value;
+    }
+
+    if (shared != nullptr) {
+        shared->tighten(alpha, beta);
+        if (alpha >= beta) {
+            // the result isn't needed any more, nothing known
+            return {Fitness::maxi(), NoWordId, Bound::upper};
+        }
+    }
+
+    // Different guesses often leave exactly the same words, so reuse what we already know. The root is only searched once.
+    if (currentDepth != 0) {
+        if (auto entry = data.m_transpositions->find(key, currentDepth)) {
+            // entry might have been reached through a different path
+            auto value = entry->m_value;
+            for (size_t i = 0; i < currentDepth; ++i) {
+                value.m_fitness[i] = path[i];
+            }
+            if (value.m_bound == Bound::exact || (value.m_bound == Bound::lower && value.m_fitness >= beta) ||
+                (value.m_bound == Bound::upper && value.m_fitness <= alpha)) {
+                return value;
+            }
+        }
+    }
+
+    // All children are leaves, and counting many words is faster with the masks. That needs the words as a set.
+    auto denseWords = WordSet();
+    auto const* remainingSet = static_cast<WordSet const*>(nullptr);
+    if (currentDepth == maxDepth - 1 && data.m_masks->isDense(remainingWords.size())) {
+        for (auto correctIdx : remainingWords) {
+            denseWords.insert(correctIdx);
+        }
+        remainingSet = &denseWords;
+    }
+
+    auto const& allowedWordsToEnter = *data.m_allowedWords;
+    auto const& guessOrder = *data.m_guessOrder;
+    auto bestValue = Result();
+
+    if (currentDepth < data.m_parallelMiniDepth) {
+        // Run loop in parallel. Loops further down fork into the same pool, so idle threads help out with slow subtrees. All
+        // threads publish their results in sharedBest, and everything below polls it.
+        auto sharedBest = SharedBest(Player::mini, shared);
+        forEachYoungBrothersWait(guessOrder.begin(), guessOrder.end(), [&](WordId const& guessIdx) {
+            data.checkDeadline();
+            auto childAlpha = alpha;
+            auto childBeta = beta;
+            sharedBest.tighten(childAlpha, childBeta);
+            if (childAlpha >= childBeta) {
+                // alpha cutoff, or the enclosing loops don't need this any more
+                sharedBest.stop();
+                return ankerl::parallel::Continue::no;
+            }
+
+            auto value = maxi(data, remainingWords, remainingSet, guessIdx, path, currentDepth, maxDepth, childAlpha,
+                              childBeta, &sharedBest);
+            if (currentDepth == 0) {
+                (*data.m_rootValues)[guessIdx] = value.m_fitness;
+            }
+            // compare by position, so equally good guesses are chosen as in the serial loop
+            auto pos = static_cast<size_t>(&guessIdx - guessOrder.data());
+            if (sharedBest.update(value, pos) && currentDepth == 0 && data.m_isVerbose) {
+                std::cout << currentDepth << ": \"" << allowedWordsToEnter[guessIdx] << "\" alpha=" << childAlpha
+                          << ", beta=" << childBeta << ", fitness=" << value.m_fitness << std::endl;
+            }
+            return ankerl::parallel::Continue::yes;
+        }, *data.m_pool);
+
+        bestValue = sharedBest.result(alpha, beta);
+        if (auto pos = sharedBest.bestIdx()) {
+            bestValue.m_guessId = guessOrder[*pos];
+        }
+    } else {
+        auto lower = Fitness::maxi();
+        auto upper = Fitness::maxi();
+        auto bestGuessId = NoWordId;
+        auto isComplete = true;
+        auto childAlpha = alpha;
+        auto childBeta = beta;
+        for (size_t pos = 0; pos < guessOrder.size(); ++pos) {
+            if (pos % 1024 == 0) {
+                data.checkDeadline();
+            }
+            if (shared != nullptr) {
+                shared->tighten(childAlpha, childBeta);
+            }
+            if (childAlpha >= childBeta) {
+                // alpha cutoff, or the enclosing loops don't need this any more
+                isComplete = false;
+                break;
+            }
+
+            auto guessIdx = guessOrder[pos];
+            auto value = maxi(data, remainingWords, remainingSet, guessIdx, path, currentDepth, maxDepth, childAlpha,
+                              childBeta, shared);
+            if (currentDepth == 0) {
+                (*data.m_rootValues)[guessIdx] = value.m_fitness;
+            }
+            lower = std::min(lower, value.lowerLimit());
+            if (value.upperLimit() < upper) {
+                upper = value.upperLimit();
+                bestGuessId = guessIdx;
+
+                if (currentDepth == 0 && data.m_isVerbose) {
+                    std::cout << currentDepth << ": \"" << allowedWordsToEnter[guessIdx] << "\" alpha=" << childAlpha
+                              << ", beta=" << childBeta << ", fitness=" << value.m_fitness << std::endl;
+                }
+            }
+            childBeta = std::min(childBeta, upper);
+        }
+
+        if (shared != nullptr) {
+            shared->tighten(alpha, beta);
+        }
+        bestValue = toResult(Player::mini, isComplete ? lower : Fitness::mini(), upper, alpha, beta);
+        bestValue.m_guessId = bestGuessId;
+    }
+
+    // Nothing to remember when the search was stopped before it found anything.
+    auto isKnown = bestValue.m_bound != Bound::upper || bestValue.m_fitness != Fitness::maxi();
+    if (currentDepth != 0 && isKnown) {
+        data.m_transpositions->store(key, currentDepth, bestValue.m_bound, bestValue);
+    }
+
+    return bestValue;
+}
+
+// maxi: wants to find the most hard to guess "correct" word
+Result maxi(SearchData const& data,
+            WordSlice remainingWords,
+            WordSet const* remainingSet,
+            size_t guessIdx,
+            Fitness const& path,
+            size_t currentDepth,
+            size_t maxDepth,
+            Fitness alpha,
+            Fitness beta,
+            SharedBest const* shared) {
+    if (shared != nullptr) {
+        shared->tighten(alpha, beta);
+        if (alpha >= beta) {
+            // the result isn't needed any more, nothing known
+            return {Fitness::mini(), NoWordId, Bound::lower};
+        }
+    }
+
+    // state codes for this guess word against all correct words
+    auto const* codes = data.m_feedback->row(guessIdx);
+
+    // Partition the remaining words by the state they produce, in a single pass. All words in one bucket are exactly the
+    // words that are still possible after this guess, so each bucket is a child node.
+    auto bucketSizes = std::array<uint16_t, NumStateCodes>{};
+
+    if (currentDepth == maxDepth - 1) {
+        // we've reached the end, just use the size of the largest bucket as the fitness value.
+        auto valueWithCount = [&](size_t count) {
+            auto value = Result{path, NoWordId};
+            value.m_fitness[currentDepth] = count;
+            return value;
+        };
+
+        // The value only grows with the count, so find the count where it reaches beta. Then we don't need to compare the
+        // whole fitness for each word.
+        auto cutoffCount = std::numeric_limits<size_t>::max();
+        if (valueWithCount(0).m_fitness >= beta) {
+            cutoffCount = 0;
+        } else if (beta[currentDepth] != std::numeric_limits<size_t>::max()) {
+            if (valueWithCount(beta[currentDepth]).m_fitness >= beta) {
+                cutoffCount = beta[currentDepth];
+            } else if (valueWithCount(beta[currentDepth] + 1).m_fitness >= beta) {
+                cutoffCount = beta[currentDepth] + 1;
+            }
+        }
+
+        auto maxCount = size_t();
+        auto isCounted = false;
+        if (remainingSet != nullptr) {
+            // AND + popcount for each large bucket. The small buckets don't have masks, but when one of the large ones has
+            // more words left than any small bucket has at all, that's already the maximum.
+            auto const& masks = *data.m_masks;
+            for (auto const* mask = masks.begin(guessIdx); mask != masks.end(guessIdx) && maxCount < cutoffCount; ++mask) {
+                maxCount = std::max(maxCount, remainingSet->intersectionSize(*mask));
+            }
+            isCounted = maxCount >= cutoffCount || maxCount >= masks.maxSparseSize(guessIdx);
+        }
+        if (!isCounted) {
+            maxCount = 0;
+            for (auto correctIdx : remainingWords) {
+                auto code = codes[correctIdx];
+                // The guess word itself is only possible with all letters correct, and that's already solved.
+                if (code != AllCorrectStateCode && ++bucketSizes[code] > maxCount) {
+                    maxCount = bucketSizes[code];
+                    if (maxCount >= cutoffCount) {
+                        // beta cutoff, stop counting
+                        break;
+                    }
+                }
+            }
+        }
+        auto value = valueWithCount(maxCount);
+        if (maxCount >= cutoffCount) {
+            value.m_bound = Bound::lower;
+        }
+        return value;
+    }
+
+    for (auto correctIdx : remainingWords) {
+        ++bucketSizes[codes[correctIdx]];
+    }
+    bucketSizes[AllCorrectStateCode] = 0;
+
+    // we have to go deeper. Sort words by bucket (counting sort), so each bucket is a contiguous range.
+    auto bucketBegin = std::array<uint16_t, NumStateCodes>{};
+    auto nonEmptyBuckets = std::array<uint8_t, NumStateCodes>{};
+    auto numNonEmptyBuckets = size_t();
+    auto numWords = uint16_t();
+    for (size_t code = 0; code < NumStateCodes; ++code) {
+        bucketBegin[code] = numWords;
+        numWords += bucketSizes[code];
+        if (bucketSizes[code] != 0) {
+            nonEmptyBuckets[numNonEmptyBuckets++] = static_cast<uint8_t>(code);
+        }
+    }
+    auto sortedWords = std::array<uint16_t, WordSet::MaxWords>();
+    auto insertPos = bucketBegin;
+    for (auto correctIdx : remainingWords) {
+        auto code = codes[correctIdx];
+        if (code != AllCorrectStateCode) {
+            sortedWords[insertPos[code]++] = correctIdx;
+        }
+    }
+
+    // Largest buckets first: they most likely produce the maximum, so the beta cutoff comes early.
+    std::sort(nonEmptyBuckets.begin(), nonEmptyBuckets.begin() + numNonEmptyBuckets, [&](uint8_t a, uint8_t b) {
+        return bucketSizes[a] > bucketSizes[b];
+    });
+
+    // sortedWords stays alive until all children are finished, so they can use their bucket in place
+    auto searchBucket = [&](uint8_t code, Fitness const& childAlpha, Fitness const& childBeta, SharedBest const* childShared) {
+        auto const* bucket = sortedWords.data() + bucketBegin[code];
+        auto childPath = path;
+        childPath[currentDepth] = bucketSizes[code];
+        return mini(data, WordSlice(bucket, bucket + bucketSizes[code]), childPath, currentDepth + 1, maxDepth, childAlpha,
+                    childBeta, childShared);
+    };
+
+    if (currentDepth < data.m_parallelMaxiDepth) {
+        auto sharedBest = SharedBest(Player::maxi, shared);
+        auto bucketsEnd = nonEmptyBuckets.begin() + numNonEmptyBuckets;
+        forEachYoungBrothersWait(nonEmptyBuckets.begin(), bucketsEnd, [&](uint8_t const& code) {
+            auto childAlpha = alpha;
+            auto childBeta = beta;
+            sharedBest.tighten(childAlpha, childBeta);
+            if (childAlpha >= childBeta) {
+                // beta cutoff, or the enclosing loops don't need this any more
+                sharedBest.stop();
+                return ankerl::parallel::Continue::no;
+            }
+
+            auto value = searchBucket(code, childAlpha, childBeta, &sharedBest);
+            sharedBest.update(value, static_cast<size_t>(&code - nonEmptyBuckets.data()));
+            return ankerl::parallel::Continue::yes;
+        }, *data.m_pool);
+        return sharedBest.result(alpha, beta);
+    }
+
+    auto lower = Fitness::mini();
+    auto upper = Fitness::mini();
+    auto isComplete = true;
+    auto childAlpha = alpha;
+    auto childBeta = beta;
+    for (size_t i = 0; i < numNonEmptyBuckets; ++i) {
+        if (shared != nullptr) {
+            shared->tighten(childAlpha, childBeta);
+        }
+        if (childAlpha >= childBeta) {
+            // beta cutoff, or the enclosing loops don't need this any more
+            isComplete = false;
+            break;
+        }
+
+        auto value = searchBucket(nonEmptyBuckets[i], childAlpha, childBeta, shared);
+        lower = std::max(lower, value.lowerLimit());
+        upper = std::max(upper, value.upperLimit());
+        childAlpha = std::max(childAlpha, lower);
+    }
+    if (shared != nullptr) {
+        shared->tighten(alpha, beta);
+    }
+    return toResult(Player::maxi, lower, isComplete ? upper : Fitness::maxi(), alpha, beta);
+}
+
+} // namespace alphabeta
+
+/**
+ * @brief Buffers for the root of a search, reused by all searches of a thread.
+ *
+ * Everything below the root lives on the stack: each maxi() frame holds its bucket sizes and sorted words, and children get
+ * slices of them. That's a per-thread arena that is indexed by depth and reset on return for free. With these buffers, a
+ * single threaded search doesn't allocate at all once its thread has warmed up.
+ */
+struct SearchScratch {
+    std::vector<WordId> m_guessOrder{};
+    std::vector<WordId> m_previousPos{};
+    std::vector<Fitness> m_rootValues{};
+    std::vector<uint16_t> m_rootWords{};
+    bool m_isInUse = false;
+};
+
+/**
+ * @brief Searches with a depth of 1, 2, ... up to maxDepth, and returns the result of the deepest search that finished
+ * before the deadline. The deadline only applies after the first search, so there always is a result.
+ *
+ * Each iteration tries the root guesses in the order of the previous iteration's values, so that the most promising
+ * guesses establish tight bounds early.
+ */
+Result iterativeDeepening(SearchData& data,
+                          WordSet const& remainingCorrectWords,
+                          size_t maxDepth,
+                          std::optional<std::chrono::steady_clock::time_point> deadline) {
+    // A thread that waits in a parallel loop helps with other tasks, and these might start a search too. That one gets
+    // its own buffers.
+    thread_local auto threadScratch = SearchScratch();
+    auto ownScratch = std::optional<SearchScratch>();
+    auto* scratch = &threadScratch;
+    if (scratch->m_isInUse) {
+        scratch = &ownScratch.emplace();
+    }
+    scratch->m_isInUse = true;
+    struct ReleaseScratch {
+        SearchScratch* m_scratch;
+        ~ReleaseScratch() {
+            m_scratch->m_isInUse = false;
+        }
+    } releaseScratch{scratch};
+
+    auto& guessOrder = scratch->m_guessOrder;
+    guessOrder.resize(data.m_allowedWords->size());
+    std::iota(guessOrder.begin(), guessOrder.end(), WordId());
+    auto& previousPos = scratch->m_previousPos;
+    previousPos.resize(guessOrder.size());
+    auto& rootValues = scratch->m_rootValues;
+    data.m_guessOrder = &guessOrder;
+    data.m_rootValues = &rootValues;
+    data.m_deadline = std::nullopt;
+
+    // the only list of the words, all nodes below work on slices of it
+    auto& rootWords = scratch->m_rootWords;
+    rootWords.clear();
+    remainingCorrectWords.forEach([&](size_t correctIdx) {
+        rootWords.push_back(static_cast<uint16_t>(correctIdx));
+    });
+
+    auto bestResult = Result();
+    for (size_t depth = 1; depth <= maxDepth; ++depth) {
+        // values depend on the depth, so nothing in the table can be reused
+        data.m_transpositions->clear();
+        rootValues.assign(guessOrder.size(), Fitness::maxi());
+        try {
+            bestResult = alphabeta::mini(data, WordSlice(rootWords.data(), rootWords.data() + rootWords.size()),
+                                         Fitness::maxi(), 0, depth, Fitness::mini(), Fitness::maxi(), nullptr);
+        } catch (DeadlineReached const&) {
+            if (data.m_isVerbose) {
+                std::cout << "depth " << depth << ": deadline reached" << std::endl;
+            }
+            break;
+        }
+        if (data.m_isVerbose) {
+            std::cout << "depth " << depth << ": " << bestResult.m_fitness << " "
+                      << (*data.m_allowedWords)[bestResult.m_guessId] << std::endl;
+        }
+
+        // Equally good guesses stay in their previous order, so in heuristic order for the first iteration. Same as
+        // std::stable_sort, but that allocates a buffer.
+        for (size_t pos = 0; pos < guessOrder.size(); ++pos) {
+            previousPos[guessOrder[pos]] = static_cast<WordId>(pos);
+        }
+        std::sort(guessOrder.begin(), guessOrder.end(), [&](WordId a, WordId b) {
+            if (rootValues[a] != rootValues[b]) {
+                return rootValues[a] < rootValues[b];
+            }
+            return previousPos[a] < previousPos[b];
+        });
+        data.m_deadline = deadline;
+    }
+    return bestResult;
+}
+
+} // namespace
+
+std::pair<Word, State> parseWordAndState(std::string_view wordAndState) {
+    if (wordAndState.size() != NumCharacters * 2) {
+        throw std::runtime_error("incorrect number of letters");
+    }
+
+    auto word = Word();
+    auto state = State();
+    for (size_t i = 0; i < NumCharacters; ++i) {
+        // anything else would overwrite neighbouring letters, and index AlphabetMaps out of bounds
+        auto ch = wordAndState[i];
+        if (ch < 'a' || ch > 'z') {
+            throw std::runtime_error("invalid letter '" + std::string(1, ch) + "' in '" + std::string(wordAndState) + "'");
+        }
+        word.set(i, static_cast<char>(ch - 'a'));
+        switch (wordAndState[i + NumCharacters]) {
+        case '0':
+            state[i] = St::not_included;
+            break;
+        case '1':
+            state[i] = St::wrong_spot;
+            break;
+        case '2':
+            state[i] = St::correct;
+            break;
+        default:
+            throw std::runtime_error("invalid state character");
+        }
+    }
+    return std::make_pair(word, state);
+}
+
+std::vector<Word> readAndFilterDictionary(std::filesystem::path filename) {
+    return parseDictFile(filename);
+}
+
+void heuristicSort(std::vector<Word>& words) {
+    auto letterFrequency = AlphabetMap<size_t>();
+    for (auto const& word : words) {
+        for (size_t i = 0; i < word.size(); ++i) {
+            ++letterFrequency[word[i]];
+        }
+    }
+
+    auto scores = std::vector<std::pair<Word, size_t>>();
+    for (auto const& word : words) {
+        auto hasLetter = AlphabetMap<bool>();
+        auto score = size_t();
+        for (size_t i = 0; i < word.size(); ++i) {
+            auto ch = word[i];
+            if (!hasLetter[ch]) {
+                score += letterFrequency[ch];
+                hasLetter[ch] = true;
+            }
+        }
+        scores.emplace_back(word, score);
+    }
+
+    std::sort(scores.begin(), scores.end(), [](auto const& a, auto const& b) {
+        return a.second < b.second;
+    });
+
+    for (size_t i = 0; i < scores.size(); ++i) {
+        words[i] = scores[i].first;
+    }
+}
+
+namespace {
+
+/**
+ * @brief WordId of each correct word, throws when one of them isn't an allowed word.
+ */
+std::vector<WordId> correctWordIds(std::vector<Word> const& allowedWords, std::vector<Word> const& correctWords) {
+    auto ids = std::unordered_map<uint32_t, WordId>();
+    for (size_t id = 0; id < allowedWords.size(); ++id) {
+        ids.emplace(allowedWords[id].bits(), static_cast<WordId>(id));
+    }
+    auto correctIds = std::vector<WordId>();
+    correctIds.reserve(correctWords.size());
+    for (auto const& word : correctWords) {
+        auto it = ids.find(word.bits());
+        if (it == ids.end()) {
+            throw std::runtime_error("correct word is not an allowed word");
+        }
+        correctIds.push_back(it->second);
+    }
+    return correctIds;
+}
+
+} // namespace
+
+std::pair<std::vector<Word>, std::vector<Word>> readWordLists(std::string const& prefix) {
+    auto allowedWords = readAndFilterDictionary(prefix + "_allowed.txt");
+    auto correctWords = readAndFilterDictionary(prefix + "_correct.txt");
+
+    heuristicSort(allowedWords);
+    heuristicSort(correctWords);
+    std::reverse(allowedWords.begin(), allowedWords.end());
+
+    // the solution can always be entered, even when the dictionary doesn't list it
+    auto allowedBits = std::unordered_set<uint32_t>();
+    for (auto const& word : allowedWords) {
+        allowedBits.insert(word.bits());
+    }
+    for (auto const& word : correctWords) {
+        if (allowedBits.insert(word.bits()).second) {
+            allowedWords.push_back(word);
+        }
+    }
+    return std::make_pair(std::move(allowedWords), std::move(correctWords));
+}
+
+Dictionary loadDictionary(std::string const& prefix) {
+    auto allowedWords = std::vector<Word>();
+    auto correctWords = std::vector<Word>();
+    auto correctIds = std::vector<WordId>();
+    auto hash = uint64_t();
+    auto cachePrefix = std::optional<std::string>(prefix);
+
+    auto constexpr EmbeddedScheme = std::string_view("embedded:");
+    auto constexpr DatabaseExtension = std::string_view(".wdb");
+    if (prefix.compare(0, EmbeddedScheme.size(), EmbeddedScheme) == 0) {
+        auto name = prefix.substr(EmbeddedScheme.size());
+        auto const* embedded = findEmbeddedDictionary(name);
+        if (embedded == nullptr) {
+            auto dictionaries = embeddedDictionaries();
+            auto available = std::string();
+            for (size_t i = 0; i < dictionaries.m_size; ++i) {
+                available += " " + std::string(dictionaries.m_dictionaries[i].m_name);
+            }
+            throw std::runtime_error("no embedded dictionary '" + name + "', available:" +
+                                     (available.empty() ? " none, build with -Dembed_dictionaries=true" : available));
+        }
+        allowedWords.assign(embedded->m_allowedWords, embedded->m_allowedWords + embedded->m_numAllowed);
+        correctWords.assign(embedded->m_correctWords, embedded->m_correctWords + embedded->m_numCorrect);
+        correctIds = correctWordIds(allowedWords, correctWords);
+
+        // no files at all, the feedback table is always calculated
+        cachePrefix.reset();
+    } else if (prefix.size() > DatabaseExtension.size() &&
+               prefix.compare(prefix.size() - DatabaseExtension.size(), DatabaseExtension.size(), DatabaseExtension) ==
+                   0) {
+        // already in search order and with its hash, so nothing needs to be calculated
+        auto database = WordDatabase(prefix);
+        allowedWords = database.allowed().toVector();
+        correctWords = database.correct().toVector();
+        for (size_t correctIdx = 0; correctIdx < correctWords.size(); ++correctIdx) {
+            auto id = database.correctToAllowed(correctIdx);
+            if (id == WordDatabase::NotAllowed) {
+                throw std::runtime_error("correct word is not an allowed word, recreate " + prefix + " with wordle-pack");
+            }
+            correctIds.push_back(static_cast<WordId>(id));
+        }
+        hash = database.contentHash();
+        cachePrefix->resize(prefix.size() - DatabaseExtension.size());
+    } else {
+        std::tie(allowedWords, correctWords) = readWordLists(prefix);
+        correctIds = correctWordIds(allowedWords, correctWords);
+        hash = FeedbackTable::contentHash(allowedWords, correctWords);
+    }
+
+    if (correctWords.size() > WordSet::MaxWords) {
+        throw std::runtime_error("too many correct words");
+    }
+    if (allowedWords.size() > SharedBest::MaxGuesses) {
+        throw std::runtime_error("too many allowed words");
+    }
+
+    if (!cachePrefix) {
+        auto feedback = FeedbackTable(allowedWords, correctWords);
+        auto masks = FeedbackMasks(feedback);
+        auto correctColumns = WordColumns(correctWords);
+        auto allowedIndex = WordIndex(allowedWords);
+        return Dictionary{std::move(allowedWords), std::move(correctWords), std::move(correctIds), std::move(feedback),
+                          std::move(masks), std::move(correctColumns), std::move(allowedIndex)};
+    }
+
+    // calculating all states takes a while, so it is cached next to the dictionary
+    auto feedback = FeedbackTable::loadOrCreate(*cachePrefix + "_feedback.cache", allowedWords, correctWords, hash);
+    auto masks = FeedbackMasks(feedback);
+    auto correctColumns = WordColumns(correctWords);
+    auto allowedIndex = WordIndex(allowedWords);
+    return Dictionary{std::move(allowedWords), std::move(correctWords), std::move(correctIds), std::move(feedback),
+                      std::move(masks), std::move(correctColumns), std::move(allowedIndex)};
+}
+
+WordSet filterCorrectWords(Dictionary const& dict, Constraints const& constraints) {
+    auto filteredCorrectWords = WordSet();
+    for (auto correctIdx : dict.m_correctColumns.filter(constraints)) {
+        filteredCorrectWords.insert(correctIdx);
+    }
+    return filteredCorrectWords;
+}
+
+Constraints parseClues(std::istream& in) {
+    auto constraints = Constraints();
+    auto wordAndState = std::string();
+    while (in >> wordAndState) {
+        auto [word, state] = parseWordAndState(wordAndState);
+        constraints.add(word, state);
+    }
+    return constraints;
+}
+
+std::optional<std::string> answerQuery(Dictionary const& dict, std::string_view request) {
+    auto in = std::istringstream(std::string(request));
+    auto keyword = std::string();
+    if (!(in >> keyword) || keyword != "query") {
+        return std::nullopt;
+    }
+
+    // clues are the only parts with 10 characters, everything else belongs to the pattern
+    auto pattern = std::string();
+    auto clues = std::vector<std::pair<Word, State>>();
+    auto part = std::string();
+    while (in >> part) {
+        if (part.size() == NumCharacters * 2) {
+            clues.push_back(parseWordAndState(part));
+        } else {
+            pattern += part + ' ';
+        }
+    }
+    auto constraints = parsePattern(pattern);
+    for (auto const& [word, state] : clues) {
+        constraints.add(word, state);
+    }
+
+    auto indices = dict.m_allowedIndex.query(constraints);
+    auto out = std::ostringstream();
+    out << indices.size();
+    for (auto idx : indices) {
+        out << ' ' << dict.m_allowedWords[idx];
+    }
+    return out.str();
+}
+
+Result solve(Dictionary const& dict,
+             WordSet const& remainingCorrectWords,
+             TranspositionTable<Result>& transpositions,
+             size_t maxDepth,
+             std::optional<std::chrono::steady_clock::time_point> deadline,
+             bool isVerbose,
+             bool isParallel) {
+    auto* pool = &ankerl::parallel::ThreadPool::global();
+    if (!isParallel || pool->numThreads() == 1) {
+        pool = nullptr;
+    }
+    return solve(dict, remainingCorrectWords, transpositions, maxDepth, deadline, isVerbose, pool);
+}
+
+Result solve(Dictionary const& dict,
+             WordSet const& remainingCorrectWords,
+             TranspositionTable<Result>& transpositions,
+             size_t maxDepth,
+             std::optional<std::chrono::steady_clock::time_point> deadline,
+             bool isVerbose,
+             ankerl::parallel::ThreadPool* pool) {
+    auto data = SearchData{&dict.m_allowedWords,
+                           &dict.m_correctIds,
+                           &dict.m_feedback,
+                           &dict.m_masks,
+                           &transpositions,
+                           0,
+                           0,
+                           pool,
+                           nullptr,
+                           nullptr,
+                           {},
+                           isVerbose};
+    if (pool != nullptr) {
+        // parallelize the first two levels, so the slow root guesses and their largest buckets are split up among all threads
+        data.m_parallelMiniDepth = 2;
+        data.m_parallelMaxiDepth = 2;
+    }
+    return iterativeDeepening(data, remainingCorrectWords, maxDepth, deadline);
+}
+
+} // namespace wordle
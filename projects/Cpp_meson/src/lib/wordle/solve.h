@@ -0,0 +1,306 @@
+#pragma once
+
+#include <util/parallel/ThreadPool.h>
+#include <wordle/Constraints.h>
+#include <wordle/FeedbackMasks.h>
+#include <wordle/FeedbackTable.h>
+#include <wordle/State.h>
+#include <wordle/TranspositionTable.h>
+#include <wordle/WordColumns.h>
+#include <wordle/WordIndex.h>
+#include <wordle/Word.h>
+#include <wordle/WordSet.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <iosfwd>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace wordle {
+
+/**
+ * @brief Fitness score of a guess word. The lower, the better.
+ */
+struct Fitness {
+    // deepest search that can be represented
+    static constexpr size_t MaxDepth = 4;
+
+    // maximum number of remaining words for each level, but in reverse.
+    std::array<size_t, MaxDepth> m_maxCounts{};
+
+    constexpr size_t& operator[](size_t idx) {
+        return m_maxCounts[m_maxCounts.size() - idx - 1];
+    }
+
+    constexpr size_t const& operator[](size_t idx) const {
+        return m_maxCounts[m_maxCounts.size() - idx - 1];
+    }
+
+    constexpr size_t size() const {
+        return m_maxCounts.size();
+    }
+
+    constexpr static Fitness maxi() {
+        auto f = Fitness();
+        for (auto& x : f.m_maxCounts) {
+            x = std::numeric_limits<size_t>::max();
+        }
+        return f;
+    }
+    constexpr static Fitness mini() {
+        return {};
+    }
+
+    // Each count fits into 12 bits (they are at most WordSet::MaxWords), max() is stored as all ones. This keeps the
+    // ordering, so packed values can be compared directly.
+    static constexpr size_t PackedBits = 12;
+    static constexpr uint64_t PackedMax = (uint64_t(1) << PackedBits) - 1;
+
+    /**
+     * @brief Packs all counts into the lowest size() * PackedBits bits, so it can be updated atomically.
+     */
+    constexpr uint64_t pack() const {
+        auto packed = uint64_t();
+        for (auto x : m_maxCounts) {
+            packed = (packed << PackedBits) | std::min<uint64_t>(x, PackedMax);
+        }
+        return packed;
+    }
+
+    constexpr static Fitness unpack(uint64_t packed) {
+        auto f = Fitness();
+        for (auto it = f.m_maxCounts.rbegin(); it != f.m_maxCounts.rend(); ++it) {
+            auto x = packed & PackedMax;
+            *it = x == PackedMax ? std::numeric_limits<size_t>::max() : x;
+            packed >>= PackedBits;
+        }
+        return f;
+    }
+
+private:
+    /**
+     * Don't allow default ctor, only allow static worst() and best() functions so we know what we are getting
+     */
+    Fitness() = default;
+};
+
+inline std::ostream& operator<<(std::ostream& os, Fitness const& f) {
+    auto prefix = std::string_view("(");
+    std::for_each(f.m_maxCounts.rbegin(), f.m_maxCounts.rend(), [&](auto const& x) {
+        os << prefix << x;
+        prefix = ", ";
+    });
+    return os << ")";
+}
+
+inline bool operator<=(Fitness const& a, Fitness const& b) {
+    return a.m_maxCounts <= b.m_maxCounts;
+}
+inline bool operator<(Fitness const& a, Fitness const& b) {
+    return a.m_maxCounts < b.m_maxCounts;
+}
+inline bool operator>=(Fitness const& a, Fitness const& b) {
+    return a.m_maxCounts >= b.m_maxCounts;
+}
+inline bool operator>(Fitness const& a, Fitness const& b) {
+    return a.m_maxCounts > b.m_maxCounts;
+}
+inline bool operator==(Fitness const& a, Fitness const& b) {
+    return a.m_maxCounts == b.m_maxCounts;
+}
+inline bool operator!=(Fitness const& a, Fitness const& b) {
+    return a.m_maxCounts != b.m_maxCounts;
+}
+
+/**
+ * @brief Identifies a word of a Dictionary, it's the index into m_allowedWords.
+ *
+ * Every correct word can be entered too, so the correct words are a subset of the same IDs (see Dictionary::m_correctIds).
+ */
+using WordId = uint16_t;
+
+// no word, e.g. for results of searches that were cut off
+static constexpr auto NoWordId = std::numeric_limits<WordId>::max();
+
+struct Result {
+    Fitness m_fitness = Fitness::maxi();
+    WordId m_guessId = NoWordId;
+
+    // searches that were cut off only know a bound of the value
+    Bound m_bound = Bound::exact;
+
+    static Result maxi() {
+        return {Fitness::maxi(), NoWordId};
+    }
+
+    static Result mini() {
+        return {Fitness::mini(), NoWordId};
+    }
+
+    // Limits of the real value, based on the bound.
+    Fitness lowerLimit() const {
+        return m_bound == Bound::upper ? Fitness::mini() : m_fitness;
+    }
+    Fitness upperLimit() const {
+        return m_bound == Bound::lower ? Fitness::maxi() : m_fitness;
+    }
+};
+
+/**
+ * @brief Everything that is derived from one pair of dictionary files, and stays the same for all searches.
+ */
+struct Dictionary {
+    // all words that can be entered, indexed by WordId
+    std::vector<Word> m_allowedWords;
+
+    // Words that can be the solution. WordSets and the columns of m_feedback use the index into this list.
+    std::vector<Word> m_correctWords;
+
+    // WordId of each correct word
+    std::vector<WordId> m_correctIds;
+
+    FeedbackTable m_feedback;
+
+    // derived from m_feedback, the search counts dense nodes with them
+    FeedbackMasks m_masks;
+
+    // Same words as m_correctWords, in columns. Filtering them is the first step of every request, see filterCorrectWords().
+    WordColumns m_correctColumns;
+
+    // index of m_allowedWords, answers queries without a search, see answerQuery()
+    WordIndex m_allowedIndex;
+
+    Word word(WordId id) const {
+        return m_allowedWords[id];
+    }
+};
+
+/**
+ * @brief Parses a clue like "weary00102": the guess word followed by the state of each letter.
+ */
+std::pair<Word, State> parseWordAndState(std::string_view wordAndState);
+
+/**
+ * @brief Reads all space separated word-state clues from in, and merges them.
+ */
+Constraints parseClues(std::istream& in);
+
+/**
+ * @brief Reads & filters a dictionary file with newline separated words.
+ *
+ * Words are separated by '\n'. All are lowercase, exactly numCharacters long, sorted, and unique. No special characters.
+ * Read in any dictionary file. This lowercases all words, and filters all out that don't have 5 characters or any special
+ * character.
+ *
+ * @param filename Dictionary filename
+ * @return std::string One string with all lowercase concatenated words (without any separator).
+ */
+std::vector<Word> readAndFilterDictionary(std::filesystem::path filename);
+
+// Calculates a score for each word, based on letter frequency
+void heuristicSort(std::vector<Word>& words);
+
+/**
+ * @brief Reads prefix_allowed.txt and prefix_correct.txt, and brings the words into the order the search uses.
+ *
+ * Correct words that are missing in the allowed words are appended to them, so each correct word has a WordId.
+ *
+ * @return The allowed and the correct words.
+ */
+std::pair<std::vector<Word>, std::vector<Word>> readWordLists(std::string const& prefix);
+
+/**
+ * @brief Reads the words with readWordLists(), and loads or calculates their feedback table.
+ *
+ * When prefix is a file ending in ".wdb", the words are mapped from that WordDatabase instead. Either way, the feedback
+ * table is cached in <prefix without .wdb>_feedback.cache.
+ *
+ * "embedded:<name>" uses a dictionary that's compiled into the binary, see embeddedDictionaries(). That doesn't access any
+ * files, the feedback table is calculated.
+ */
+Dictionary loadDictionary(std::string const& prefix);
+
+/**
+ * @brief The correct words that satisfy the constraints.
+ */
+WordSet filterCorrectWords(Dictionary const& dict, Constraints const& constraints);
+
+/**
+ * @brief Answers a query "query <pattern> [word-state]..." with "<number of words> <word>...": all allowed words that match
+ * the pattern (see parsePattern()) and the clues. Returns std::nullopt when request doesn't start with "query", and throws
+ * std::runtime_error when it can't be parsed.
+ *
+ * The server and runBatch() accept these besides the clues to solve.
+ */
+std::optional<std::string> answerQuery(Dictionary const& dict, std::string_view request);
+
+/**
+ * @brief Finds the best guess when the correct word is one of remainingCorrectWords.
+ *
+ * Searches deeper and deeper until maxDepth or the deadline. With isParallel the search uses all threads of the pool,
+ * otherwise it runs on the calling thread only. isVerbose prints the progress to std::cout.
+ */
+Result solve(Dictionary const& dict,
+             WordSet const& remainingCorrectWords,
+             TranspositionTable<Result>& transpositions,
+             size_t maxDepth,
+             std::optional<std::chrono::steady_clock::time_point> deadline,
+             bool isVerbose,
+             bool isParallel);
+
+/**
+ * @brief Same as above, but the search uses all threads of pool. With nullptr it runs on the calling thread only.
+ */
+Result solve(Dictionary const& dict,
+             WordSet const& remainingCorrectWords,
+             TranspositionTable<Result>& transpositions,
+             size_t maxDepth,
+             std::optional<std::chrono::steady_clock::time_point> deadline,
+             bool isVerbose,
+             ankerl::parallel::ThreadPool* pool);
+
+/**
+ * @brief Transposition tables for many single threaded searches that run at the same time, each needs its own table.
+ *
+ * Tables are reused, so only as many are allocated as searches run concurrently.
+ */
+class TranspositionTablePool {
+    size_t m_numBuckets;
+    std::mutex m_mutex{};
+    std::vector<std::unique_ptr<TranspositionTable<Result>>> m_freeTables{};
+
+public:
+    explicit TranspositionTablePool(size_t numBuckets)
+        : m_numBuckets(numBuckets) {}
+
+    std::unique_ptr<TranspositionTable<Result>> acquire() {
+        {
+            auto lock = std::lock_guard<std::mutex>(m_mutex);
+            if (!m_freeTables.empty()) {
+                auto table = std::move(m_freeTables.back());
+                m_freeTables.pop_back();
+                return table;
+            }
+        }
+        return std::make_unique<TranspositionTable<Result>>(m_numBuckets);
+    }
+
+    void release(std::unique_ptr<TranspositionTable<Result>> table) {
+        auto lock = std::lock_guard<std::mutex>(m_mutex);
+        m_freeTables.push_back(std::move(table));
+    }
+};
+
+} // namespace wordle
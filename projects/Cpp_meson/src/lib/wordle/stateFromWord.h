@@ -1,6 +1,5 @@
 #pragma once
 
-#include <wordle/AlphabetMap.h>
 #include <wordle/State.h>
 #include <wordle/Word.h>
 
@@ -8,6 +7,31 @@
 
 namespace wordle {
 
+/**
+ * @brief State code (see toStateCode()) of the guess word, when correctWord is correct.
+ *
+ * Works on the packed words (SWAR): all letters are compared at once. Letters of the correct word that are used up, by a
+ * green or a yellow, are overwritten with a value that no letter has. Then a guess letter is yellow when it still matches
+ * anywhere, and the first match is used up.
+ */
+constexpr uint8_t stateCodeFromWord(Word const& correctWord, Word const& guessWord) {
+    auto green = matchingLetters(correctWord, guessWord);
+    auto remaining = Word::fromBits(correctWord.bits() | (green * Word::LetterMask));
+    auto code = 0;
+    for (size_t i = 0; i < NumCharacters; ++i) {
+        auto isGreen = (green >> (i * Word::BitsPerLetter)) & 1U;
+
+        // a green letter can't also be yellow
+        auto matches = lettersEqualTo(remaining, guessWord[i]) & (isGreen - 1U);
+        auto isYellow = matches != 0 ? 1U : 0U;
+        auto firstMatch = matches & (~matches + 1U);
+        remaining = Word::fromBits(remaining.bits() | (firstMatch * Word::LetterMask));
+
+        code = code * 3 + static_cast<int>(isGreen * 2U + isYellow);
+    }
+    return static_cast<uint8_t>(code);
+}
+
 /**
  * @brief Given a correct word and a guessing word, calculates the color for each letter.
  *
@@ -27,26 +51,7 @@ namespace wordle {
  * @return Char array with characters 0,1,2 to represent the matching state.
  */
 constexpr State stateFromWord(Word const& correctWord, Word const& guessWord) {
-    auto state = State();
-    auto counts = AlphabetMap<uint8_t>();
-
-    for (int i = 0; i < NumCharacters; ++i) {
-        if (guessWord[i] == correctWord[i]) {
-            state[i] = St::correct;
-        } else {
-            ++counts[correctWord[i]];
-            state[i] = St::not_included;
-        }
-    }
-
-    for (int i = 0; i < NumCharacters; ++i) {
-        if (guessWord[i] != correctWord[i] && counts[guessWord[i]]) {
-            state[i] = St::wrong_spot;
-            --counts[guessWord[i]];
-        }
-    }
-
-    return state;
+    return fromStateCode(stateCodeFromWord(correctWord, guessWord));
 }
 
 } // namespace wordle
@@ -0,0 +1,201 @@
+#include <wordle/Isa.h>
+#include <wordle/State.h>
+#include <wordle/stateFromWord.h>
+#include <wordle/statesFromWord.h>
+
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#    define WORDLE_HAS_X86_KERNELS 1
+#    include <immintrin.h>
+#endif
+
+namespace wordle {
+
+void statesFromWordScalar(Word const& guessWord, WordColumnPointers const& correctColumns, size_t numCorrect, uint8_t* codes) {
+    for (size_t w = 0; w < numCorrect; ++w) {
+        auto correctWord = Word();
+        for (size_t i = 0; i < NumCharacters; ++i) {
+            correctWord.set(i, correctColumns[i][w]);
+        }
+        codes[w] = stateCodeFromWord(correctWord, guessWord);
+    }
+}
+
+#if defined(WORDLE_HAS_X86_KERNELS)
+
+namespace {
+
+// Vector types for Width words, and the comparisons of the kernel. GCC loses vector_size attributes that depend on a
+// template parameter, so everything is spelled out like FilterVectors in WordColumns.cpp.
+//
+// With AVX-512, GCC at -O3 combines plain vector comparisons into boolean vectors with a byte per lane, has no instructions
+// for these and splits them into single bytes. That made the kernel 30 times slower than AVX2. The mask intrinsics give
+// plain byte vectors instead. Results are passed by reference, so the ABI doesn't depend on the instruction set.
+template <size_t Width>
+struct StateVectors;
+
+template <>
+struct StateVectors<16> {
+    typedef signed char Vec __attribute__((vector_size(16)));
+    typedef unsigned char UVec __attribute__((vector_size(16)));
+
+    static void equal(Vec const& a, Vec const& b, Vec& result) {
+        result = a == b;
+    }
+
+    static void greater(Vec const& a, Vec const& b, Vec& result) {
+        result = a > b;
+    }
+};
+
+template <>
+struct StateVectors<32> {
+    typedef signed char Vec __attribute__((vector_size(32)));
+    typedef unsigned char UVec __attribute__((vector_size(32)));
+
+    static void equal(Vec const& a, Vec const& b, Vec& result) {
+        result = a == b;
+    }
+
+    static void greater(Vec const& a, Vec const& b, Vec& result) {
+        result = a > b;
+    }
+};
+
+template <>
+struct StateVectors<64> {
+    typedef signed char Vec __attribute__((vector_size(64)));
+    typedef unsigned char UVec __attribute__((vector_size(64)));
+
+    __attribute__((target("avx512f,avx512bw"))) static void equal(Vec const& a, Vec const& b, Vec& result) {
+        result = reinterpret_cast<Vec>(
+            _mm512_movm_epi8(_mm512_cmpeq_epi8_mask(reinterpret_cast<__m512i>(a), reinterpret_cast<__m512i>(b))));
+    }
+
+    __attribute__((target("avx512f,avx512bw"))) static void greater(Vec const& a, Vec const& b, Vec& result) {
+        result = reinterpret_cast<Vec>(
+            _mm512_movm_epi8(_mm512_cmpgt_epi8_mask(reinterpret_cast<__m512i>(a), reinterpret_cast<__m512i>(b))));
+    }
+};
+
+// The kernel is written once with the compiler's vector extensions, and inlined into a function for each instruction set.
+// Inlining lets the compiler use the caller's instruction set, so Width bytes are processed with single instructions.
+//
+// Each byte lane works on one correct word. Comparisons produce -1 for true, so subtracting a mask counts.
+//
+// A guess letter that isn't green gets yellow when the correct word has more non-green occurrences of that letter than
+// there are non-green occurrences of it earlier in the guess. That's exactly what stateFromWord() does with its counts, but
+// without any branches.
+template <size_t Width>
+__attribute__((always_inline)) inline void
+statesFromWordVector(Word const& guessWord, WordColumnPointers const& correctColumns, size_t numCorrect, uint8_t* codes) {
+    using Vectors = StateVectors<Width>;
+    using Vec = typename Vectors::Vec;
+    using UVec = typename Vectors::UVec;
+
+    // plain arrays, std::array would drop the vector type's alignment attributes
+    Vec guessLetters[NumCharacters];
+    for (size_t i = 0; i < NumCharacters; ++i) {
+        guessLetters[i] = Vec{} + static_cast<signed char>(guessWord[i]);
+    }
+
+    // weight of each position in the base-3 code
+    auto constexpr weights = std::array<uint8_t, NumCharacters>{81, 27, 9, 3, 1};
+
+    size_t w = 0;
+    for (; w + Width <= numCorrect; w += Width) {
+        Vec green[NumCharacters];
+        Vec correctLetters[NumCharacters];
+        for (size_t i = 0; i < NumCharacters; ++i) {
+            std::memcpy(&correctLetters[i], correctColumns[i] + w, Width);
+            Vectors::equal(correctLetters[i], guessLetters[i], green[i]);
+        }
+
+        UVec code = {};
+        for (size_t i = 0; i < NumCharacters; ++i) {
+            // non-green letters of the correct word that are the same as guess letter i
+            Vec available = {};
+            for (size_t j = 0; j < NumCharacters; ++j) {
+                Vec same = {};
+                Vectors::equal(correctLetters[j], guessLetters[i], same);
+                available -= same & ~green[j];
+            }
+
+            // non-green earlier guess letters that are the same, these use up the yellows first
+            Vec used = {};
+            for (size_t k = 0; k < i; ++k) {
+                if (guessWord[k] == guessWord[i]) {
+                    used -= ~green[k];
+                }
+            }
+
+            Vec yellow = {};
+            Vectors::greater(available, used, yellow);
+            yellow &= ~green[i];
+            code += reinterpret_cast<UVec const&>(green[i]) & static_cast<uint8_t>(2 * weights[i]);
+            code += reinterpret_cast<UVec const&>(yellow) & weights[i];
+        }
+        std::memcpy(codes + w, &code, Width);
+    }
+
+    // remaining words that don't fill a whole register
+    auto tailColumns = correctColumns;
+    for (auto& column : tailColumns) {
+        column += w;
+    }
+    statesFromWordScalar(guessWord, tailColumns, numCorrect - w, codes + w);
+}
+
+} // namespace
+
+__attribute__((target("sse4.2"))) void
+statesFromWordSse42(Word const& guessWord, WordColumnPointers const& correctColumns, size_t numCorrect, uint8_t* codes) {
+    statesFromWordVector<16>(guessWord, correctColumns, numCorrect, codes);
+}
+
+__attribute__((target("avx2"))) void
+statesFromWordAvx2(Word const& guessWord, WordColumnPointers const& correctColumns, size_t numCorrect, uint8_t* codes) {
+    statesFromWordVector<32>(guessWord, correctColumns, numCorrect, codes);
+}
+
+__attribute__((target("avx512f,avx512bw"))) void
+statesFromWordAvx512(Word const& guessWord, WordColumnPointers const& correctColumns, size_t numCorrect, uint8_t* codes) {
+    statesFromWordVector<64>(guessWord, correctColumns, numCorrect, codes);
+}
+
+#else
+
+// isSupported() is false for all of these, but keep them callable
+void statesFromWordSse42(Word const& guessWord, WordColumnPointers const& correctColumns, size_t numCorrect, uint8_t* codes) {
+    statesFromWordScalar(guessWord, correctColumns, numCorrect, codes);
+}
+
+void statesFromWordAvx2(Word const& guessWord, WordColumnPointers const& correctColumns, size_t numCorrect, uint8_t* codes) {
+    statesFromWordScalar(guessWord, correctColumns, numCorrect, codes);
+}
+
+void statesFromWordAvx512(Word const& guessWord, WordColumnPointers const& correctColumns, size_t numCorrect, uint8_t* codes) {
+    statesFromWordScalar(guessWord, correctColumns, numCorrect, codes);
+}
+
+#endif
+
+void statesFromWord(Word const& guessWord, WordColumnPointers const& correctColumns, size_t numCorrect, uint8_t* codes) {
+    switch (activeIsa()) {
+    case Isa::avx512:
+        statesFromWordAvx512(guessWord, correctColumns, numCorrect, codes);
+        break;
+    case Isa::avx2:
+        statesFromWordAvx2(guessWord, correctColumns, numCorrect, codes);
+        break;
+    case Isa::sse42:
+        statesFromWordSse42(guessWord, correctColumns, numCorrect, codes);
+        break;
+    case Isa::scalar:
+        statesFromWordScalar(guessWord, correctColumns, numCorrect, codes);
+        break;
+    }
+}
+
+} // namespace wordle
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <wordle/Word.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace wordle {
+
+/**
+ * @brief Letters of many words, stored position-major: columns[i][w] is letter i of word w.
+ */
+using WordColumnPointers = std::array<char const*, NumCharacters>;
+
+/**
+ * @brief Calculates the state codes (see toStateCode()) of one guess word against many correct words.
+ *
+ * codes[w] = toStateCode(stateFromWord(correct word w, guessWord)) for all w < numCorrect. Uses the kernel for activeIsa(), so
+ * with AVX2 32 words are processed at once.
+ */
+void statesFromWord(Word const& guessWord, WordColumnPointers const& correctColumns, size_t numCorrect, uint8_t* codes);
+
+/**
+ * @brief Same as statesFromWord(), but one word at a time with stateCodeFromWord().
+ */
+void statesFromWordScalar(Word const& guessWord, WordColumnPointers const& correctColumns, size_t numCorrect, uint8_t* codes);
+
+/**
+ * @brief SSE4.2 implementation of statesFromWord(). Only call this when isSupported(Isa::sse42) is true.
+ */
+void statesFromWordSse42(Word const& guessWord, WordColumnPointers const& correctColumns, size_t numCorrect, uint8_t* codes);
+
+/**
+ * @brief AVX2 implementation of statesFromWord(). Only call this when isSupported(Isa::avx2) is true.
+ */
+void statesFromWordAvx2(Word const& guessWord, WordColumnPointers const& correctColumns, size_t numCorrect, uint8_t* codes);
+
+/**
+ * @brief AVX-512 implementation of statesFromWord(). Only call this when isSupported(Isa::avx512) is true.
+ */
+void statesFromWordAvx512(Word const& guessWord, WordColumnPointers const& correctColumns, size_t numCorrect, uint8_t* codes);
+
+} // namespace wordle
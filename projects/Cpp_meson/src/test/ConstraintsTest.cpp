@@ -0,0 +1,81 @@
+#include <wordle/Constraints.h>
+#include <wordle/parseDict.h>
+#include <wordle/stateFromWord.h>
+#include <wordle_util.h>
+
+#include <doctest.h>
+
+#include <fstream>
+#include <utility>
+#include <vector>
+
+namespace wordle {
+
+constexpr bool isWordValid(std::initializer_list<std::pair<Word, State>> clues, Word const& checkWord) {
+    auto constraints = Constraints();
+    for (auto const& [guessWord, state] : clues) {
+        constraints.add(guessWord, state);
+    }
+    return constraints(checkWord);
+}
+
+TEST_CASE("constraints") {
+    static_assert(isWordValid({}, "awake"_word));
+    static_assert(!isWordValid({{"awake"_word, "00000"_state}}, "focal"_word));
+    static_assert(isWordValid({{"awake"_word, "00000"_state}}, "floss"_word));
+
+    // a grey duplicate proves the exact count
+    static_assert(isWordValid({{"abcde"_word, "02200"_state}}, "xbcxc"_word));
+    static_assert(isWordValid({{"geese"_word, "21000"_state}}, "gxxex"_word));
+    static_assert(!isWordValid({{"geese"_word, "21000"_state}}, "gxxee"_word));
+    static_assert(!isWordValid({{"geese"_word, "21000"_state}}, "gexxx"_word));
+
+    // clues are merged
+    static_assert(isWordValid({{"raise"_word, "00002"_state}, {"cloak"_word, "00200"_state}}, "xxoxe"_word));
+    static_assert(!isWordValid({{"raise"_word, "00002"_state}, {"cloak"_word, "00200"_state}}, "xxoae"_word));
+    static_assert(!isWordValid({{"raise"_word, "00002"_state}, {"cloak"_word, "00200"_state}}, "xoxxe"_word));
+
+    // contradicting clues
+    static_assert(!isWordValid({{"raise"_word, "20000"_state}, {"rough"_word, "00000"_state}}, "rxxxx"_word));
+    static_assert(!isWordValid({{"abbey"_word, "00010"_state}}, "xxxbx"_word));
+    static_assert(!isWordValid({{"geese"_word, "20100"_state}}, "gxxex"_word)); // yellow after grey can't happen
+    static_assert(!isWordValid({{"aaaaa"_word, "11111"_state}}, "aaaaa"_word));
+    static_assert(!isWordValid({{"abcde"_word, "11111"_state}, {"fghij"_word, "00001"_state}}, "edcba"_word));
+}
+
+TEST_CASE("constraints-dictionary") {
+    auto fin = std::ifstream(WORDLE_DATA_DIR "/data/en_allowed.txt");
+    auto words = parseDict(fin);
+    REQUIRE(words.size() == 12972);
+
+    // a few games, each clue is added one by one. Constraints have to pass exactly the words that give the same states.
+    auto guesses = {"raise"_word, "zanza"_word, "stele"_word, "abaca"_word, "pills"_word, "geese"_word};
+    for (auto correctWord : {"gouge"_word, "jeans"_word, "knoll"_word, "pleat"_word, "solar"_word, "eerie"_word}) {
+        auto constraints = Constraints();
+        auto clues = std::vector<std::pair<Word, State>>();
+        for (auto guessWord : guesses) {
+            clues.emplace_back(guessWord, stateFromWord(correctWord, guessWord));
+            constraints.add(clues.back().first, clues.back().second);
+            REQUIRE(constraints.isSatisfiable());
+
+            auto expected = std::vector<Word>();
+            auto actual = std::vector<Word>();
+            for (auto const& word : words) {
+                auto isExpected = true;
+                for (auto const& [clueWord, clueState] : clues) {
+                    isExpected = isExpected && stateFromWord(word, clueWord) == clueState;
+                }
+                if (isExpected) {
+                    expected.push_back(word);
+                }
+                if (constraints(word)) {
+                    actual.push_back(word);
+                }
+            }
+            REQUIRE(actual == expected);
+        }
+        REQUIRE(constraints(correctWord));
+    }
+}
+
+} // namespace wordle
@@ -0,0 +1,74 @@
+#include <wordle/FeedbackMasks.h>
+#include <wordle_util.h>
+
+#include <doctest.h>
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+namespace wordle {
+
+TEST_CASE("FeedbackMasks") {
+    auto guessWords = std::vector<Word>{"bough"_word, "raise"_word, "gouge"_word, "zanza"_word, "crane"_word};
+    auto correctWords = std::vector<Word>{"gouge"_word, "jeans"_word, "shark"_word, "rouge"_word, "cigar"_word,
+                                          "rebut"_word, "sissy"_word, "humph"_word, "awake"_word, "blush"_word};
+    auto feedback = FeedbackTable(guessWords, correctWords);
+
+    CHECK(FeedbackMasks().empty());
+    CHECK(!FeedbackMasks().isDense(WordSet::MaxWords));
+
+    // no node can have 11 words
+    CHECK(FeedbackMasks(feedback, 1, 11).empty());
+    CHECK(FeedbackMasks(feedback, 1, 11).find(0, 0) == nullptr);
+
+    for (size_t minBucketSize : {1, 2, 3, 11}) {
+        auto masks = FeedbackMasks(feedback, minBucketSize, 5);
+        REQUIRE(!masks.empty());
+        CHECK(masks.minBucketSize() == minBucketSize);
+        CHECK(!masks.isDense(4));
+        CHECK(masks.isDense(5));
+
+        for (size_t g = 0; g < guessWords.size(); ++g) {
+            auto buckets = std::array<WordSet, NumStateCodes>{};
+            for (size_t c = 0; c < correctWords.size(); ++c) {
+                buckets[feedback(g, c)].insert(c);
+            }
+
+            // exactly the large buckets have a mask, except the guess word itself
+            auto maxSparseSize = size_t();
+            for (size_t code = 0; code < NumStateCodes; ++code) {
+                auto const* mask = masks.find(g, static_cast<uint8_t>(code));
+                if (code != AllCorrectStateCode && buckets[code].size() >= minBucketSize) {
+                    REQUIRE(mask != nullptr);
+                    CHECK(*mask == buckets[code]);
+                } else {
+                    CHECK(mask == nullptr);
+                    if (code != AllCorrectStateCode) {
+                        maxSparseSize = std::max(maxSparseSize, buckets[code].size());
+                    }
+                }
+            }
+            CHECK(masks.maxSparseSize(g) == maxSparseSize);
+
+            // codes and masks are in the same order
+            auto const* codes = masks.codes(g);
+            CHECK(std::is_sorted(codes, codes + (masks.end(g) - masks.begin(g))));
+            for (auto const* mask = masks.begin(g); mask != masks.end(g); ++mask) {
+                CHECK(*mask == buckets[codes[mask - masks.begin(g)]]);
+            }
+        }
+    }
+
+    // gouge is a correct word, its own bucket never gets a mask, even when all the others of the guess have one
+    auto masks = FeedbackMasks(feedback, 1, 5);
+    REQUIRE(!masks.empty());
+    CHECK(feedback(2, 0) == AllCorrectStateCode);
+    CHECK(masks.end(2) - masks.begin(2) > 0);
+    for (size_t c = 1; c < correctWords.size(); ++c) {
+        CHECK(masks.find(2, feedback(2, c)) != nullptr);
+    }
+    CHECK(masks.find(2, AllCorrectStateCode) == nullptr);
+}
+
+} // namespace wordle
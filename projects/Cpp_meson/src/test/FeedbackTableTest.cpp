@@ -0,0 +1,70 @@
+#include <wordle/FeedbackTable.h>
+#include <wordle/stateFromWord.h>
+#include <wordle_util.h>
+
+#include <doctest.h>
+
+#include <filesystem>
+
+namespace wordle {
+
+static_assert(toStateCode("00000"_state) == 0);
+static_assert(toStateCode("00001"_state) == 1);
+static_assert(toStateCode("10000"_state) == 81);
+static_assert(toStateCode("22222"_state) == AllCorrectStateCode);
+static_assert(fromStateCode(toStateCode("01210"_state)) == "01210"_state);
+static_assert(fromStateCode(toStateCode("20012"_state)) == "20012"_state);
+
+TEST_CASE("FeedbackTable") {
+    auto guessWords = std::vector<Word>{"bough"_word, "raise"_word, "gouge"_word, "zanza"_word};
+    auto correctWords = std::vector<Word>{"gouge"_word, "jeans"_word, "shark"_word};
+
+    auto table = FeedbackTable(guessWords, correctWords);
+    REQUIRE(table.numGuesses() == guessWords.size());
+    REQUIRE(table.numCorrect() == correctWords.size());
+
+    for (size_t g = 0; g < guessWords.size(); ++g) {
+        for (size_t c = 0; c < correctWords.size(); ++c) {
+            CHECK(table(g, c) == toStateCode(stateFromWord(correctWords[c], guessWords[g])));
+            CHECK(table.row(g)[c] == table(g, c));
+        }
+    }
+
+    CHECK(fromStateCode(table(0, 0)) == "02220"_state);
+    CHECK(table(2, 0) == AllCorrectStateCode);
+    CHECK(fromStateCode(table(3, 2)) == "01000"_state);
+}
+
+TEST_CASE("FeedbackTable-cache") {
+    auto guessWords = std::vector<Word>{"bough"_word, "raise"_word, "gouge"_word, "zanza"_word};
+    auto correctWords = std::vector<Word>{"gouge"_word, "jeans"_word, "shark"_word};
+
+    auto cacheFile = std::filesystem::temp_directory_path() / "wordle-FeedbackTableTest.cache";
+    std::filesystem::remove(cacheFile);
+
+    // first time it's calculated and written
+    auto created = FeedbackTable::loadOrCreate(cacheFile, guessWords, correctWords);
+    CHECK(!created.isMapped());
+    REQUIRE(std::filesystem::exists(cacheFile));
+
+    auto loaded = FeedbackTable::loadOrCreate(cacheFile, guessWords, correctWords);
+    CHECK(loaded.isMapped());
+    REQUIRE(loaded.numGuesses() == guessWords.size());
+    REQUIRE(loaded.numCorrect() == correctWords.size());
+    for (size_t g = 0; g < guessWords.size(); ++g) {
+        for (size_t c = 0; c < correctWords.size(); ++c) {
+            CHECK(loaded(g, c) == created(g, c));
+        }
+    }
+
+    // different order of the words has a different hash, so the cache is recreated
+    std::swap(correctWords[0], correctWords[1]);
+    auto recreated = FeedbackTable::loadOrCreate(cacheFile, guessWords, correctWords);
+    CHECK(!recreated.isMapped());
+    CHECK(recreated(2, 1) == AllCorrectStateCode);
+    CHECK(FeedbackTable::loadOrCreate(cacheFile, guessWords, correctWords).isMapped());
+
+    std::filesystem::remove(cacheFile);
+}
+
+} // namespace wordle
@@ -0,0 +1,43 @@
+#include <wordle/Isa.h>
+
+#include <doctest.h>
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace wordle {
+
+TEST_CASE("isa-parse") {
+    for (auto isa : {Isa::scalar, Isa::sse42, Isa::avx2, Isa::avx512}) {
+        REQUIRE(parseIsa(isaName(isa)) == isa);
+    }
+    REQUIRE(parseIsa("sse4.2") == Isa::sse42);
+    REQUIRE_THROWS_AS(parseIsa("avx"), std::runtime_error);
+    REQUIRE_THROWS_AS(parseIsa(""), std::runtime_error);
+
+    auto ss = std::ostringstream();
+    ss << Isa::avx2;
+    REQUIRE(ss.str() == "avx2");
+}
+
+TEST_CASE("isa-force") {
+    REQUIRE(isSupported(Isa::scalar));
+    REQUIRE(isSupported(bestIsa()));
+    MESSAGE("best instruction set: " << std::string(isaName(bestIsa())));
+
+    auto previousIsa = activeIsa();
+    for (auto isa : {Isa::scalar, Isa::sse42, Isa::avx2, Isa::avx512}) {
+        if (isSupported(isa)) {
+            forceIsa(isa);
+            REQUIRE(activeIsa() == isa);
+        } else {
+            REQUIRE_THROWS_AS(forceIsa(isa), std::runtime_error);
+            REQUIRE(activeIsa() != isa);
+        }
+    }
+    forceIsa(previousIsa);
+    REQUIRE(activeIsa() == previousIsa);
+}
+
+} // namespace wordle
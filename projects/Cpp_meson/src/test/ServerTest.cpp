@@ -0,0 +1,74 @@
+#include <wordle/Server.h>
+
+#include <doctest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+namespace wordle {
+
+namespace {
+
+bool startsWith(std::string const& str, std::string const& prefix) {
+    return str.compare(0, prefix.size(), prefix) == 0;
+}
+
+} // namespace
+
+TEST_CASE("Server") {
+    auto dir = std::filesystem::temp_directory_path() / "wordle-ServerTest";
+    std::filesystem::create_directories(dir);
+    {
+        auto allowed = std::ofstream(dir / "tiny_allowed.txt");
+        allowed << "bough\nraise\ngouge\nzanza\nshark\n";
+        auto correct = std::ofstream(dir / "tiny_correct.txt");
+        correct << "gouge\njeans\nshark\n";
+    }
+
+    auto server = Server(dir, 2, std::nullopt);
+
+    // only shark is left
+    auto response = server.respond("tiny shark22222");
+    CHECK(response.size() > 6);
+    CHECK(response.substr(response.size() - 6) == " shark");
+    CHECK(server.answer("tiny  shark22222  ") == response);
+
+    // malformed requests are answered with an error, and the server keeps working
+    CHECK_THROWS_AS(server.answer("tiny ~~~~~00000"), std::runtime_error);
+    CHECK(startsWith(server.respond("tiny ~~~~~00000"), "error: invalid letter"));
+    CHECK(startsWith(server.respond("tiny WEARY00102"), "error: invalid letter"));
+    CHECK(startsWith(server.respond("tiny weary00103"), "error: "));
+    CHECK(startsWith(server.respond("tiny weary0010"), "error: "));
+    CHECK(startsWith(server.respond("tiny jeans22222 shark22222"), "error: no correct word"));
+    CHECK(startsWith(server.respond(""), "error: empty request"));
+    CHECK(startsWith(server.respond("../tiny"), "error: invalid dictionary name"));
+    CHECK(startsWith(server.respond("missing"), "error: "));
+    CHECK(server.respond("tiny shark22222") == response);
+
+    // queries list the allowed words, jeans is one too because it's a correct word
+    CHECK(server.answer("tiny query ?o??e") == "1 gouge");
+    CHECK(server.answer("tiny query ????? raise00000") == "1 bough");
+    CHECK(server.answer("tiny query j????") == "1 jeans");
+    CHECK(server.answer("tiny query +zz") == "1 zanza");
+    CHECK(startsWith(server.respond("tiny query ?o"), "error: invalid pattern part"));
+
+    // requests can arrive in pieces, incomplete lines wait for the rest
+    auto client = Server::Client();
+    CHECK(server.receive(client, "tiny shark"));
+    CHECK(client.m_output.empty());
+    CHECK(server.receive(client, "22222\n../tiny\ntiny sh"));
+    CHECK(client.m_output == response + "\n" + server.respond("../tiny") + "\n");
+    CHECK(client.m_input == "tiny sh");
+
+    // a line that's too long is not buffered forever
+    client = Server::Client();
+    CHECK(server.receive(client, std::string(Server::MaxRequestSize, 'a')));
+    CHECK(!server.receive(client, "a"));
+
+    std::filesystem::remove_all(dir);
+}
+
+} // namespace wordle
@@ -0,0 +1,78 @@
+#include <util/parallel/ThreadPool.h>
+#include <util/parallel/for_each.h>
+
+#include <doctest.h>
+
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+namespace ankerl::parallel {
+
+TEST_CASE("ThreadPool-TaskGroup") {
+    auto pool = ThreadPool(4);
+    auto counter = std::atomic<int>();
+    auto group = TaskGroup(pool);
+    for (int i = 0; i < 100; ++i) {
+        group.run([&] {
+            ++counter;
+        });
+    }
+    group.wait();
+    CHECK(counter == 100);
+}
+
+TEST_CASE("ThreadPool-exception") {
+    auto pool = ThreadPool(3);
+    auto group = TaskGroup(pool);
+    group.run([] {
+        throw std::runtime_error("oops");
+    });
+    CHECK_THROWS_AS(group.wait(), std::runtime_error);
+}
+
+TEST_CASE("ThreadPool-nested-for_each") {
+    auto pool = ThreadPool(4);
+    auto outer = std::vector<int>(50);
+    std::iota(outer.begin(), outer.end(), 0);
+
+    auto sum = std::atomic<int>();
+    for_each(
+        outer.begin(),
+        outer.end(),
+        [&](int x) {
+            // nested loop forks into the same pool
+            for_each(
+                outer.begin(),
+                outer.end(),
+                [&](int y) {
+                    sum += x * y;
+                },
+                pool);
+        },
+        pool);
+
+    // (0 + 1 + ... + 49)^2
+    CHECK(sum == 1225 * 1225);
+}
+
+TEST_CASE("ThreadPool-for_each-stop") {
+    auto pool = ThreadPool(1);
+    auto items = std::vector<int>(1000);
+    std::iota(items.begin(), items.end(), 0);
+
+    // single thread works from the front, so stopping at 10 skips everything afterwards
+    auto numCalls = std::atomic<int>();
+    for_each(
+        items.begin(),
+        items.end(),
+        [&](int x) {
+            ++numCalls;
+            return x == 10 ? Continue::no : Continue::yes;
+        },
+        pool);
+    CHECK(numCalls == 11);
+}
+
+} // namespace ankerl::parallel
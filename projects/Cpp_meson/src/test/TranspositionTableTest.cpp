@@ -0,0 +1,55 @@
+#include <wordle/TranspositionTable.h>
+
+#include <doctest.h>
+
+namespace wordle {
+
+TEST_CASE("TranspositionTable") {
+    auto tt = TranspositionTable<int>(3);
+    REQUIRE(tt.numBuckets() == 4);
+
+    CHECK(!tt.find(123, 1));
+    tt.store(123, 1, Bound::exact, 42);
+
+    auto entry = tt.find(123, 1);
+    REQUIRE(entry);
+    CHECK(entry->m_value == 42);
+    CHECK(entry->m_bound == Bound::exact);
+
+    // same key but different depth is something else
+    CHECK(!tt.find(123, 2));
+
+    // overwrite
+    tt.store(123, 1, Bound::lower, 7);
+    entry = tt.find(123, 1);
+    REQUIRE(entry);
+    CHECK(entry->m_value == 7);
+    CHECK(entry->m_bound == Bound::lower);
+}
+
+TEST_CASE("TranspositionTable-replacement") {
+    auto tt = TranspositionTable<int>(1);
+
+    // everything lands in the same bucket
+    tt.store(1, 2, Bound::exact, 1);
+    tt.store(2, 1, Bound::exact, 2);
+    tt.store(3, 3, Bound::exact, 3);
+
+    // key 2 is closest to the root, so it's kept. Key 3 replaced key 1.
+    CHECK(tt.find(2, 1));
+    CHECK(tt.find(3, 3));
+    CHECK(!tt.find(1, 2));
+
+    tt.store(4, 3, Bound::exact, 4);
+    CHECK(tt.find(2, 1));
+    CHECK(tt.find(4, 3));
+    CHECK(!tt.find(3, 3));
+
+    tt.clear();
+    CHECK(!tt.find(2, 1));
+    CHECK(!tt.find(4, 3));
+    tt.store(5, 2, Bound::exact, 5);
+    CHECK(tt.find(5, 2));
+}
+
+} // namespace wordle
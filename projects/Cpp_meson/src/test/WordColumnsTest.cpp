@@ -0,0 +1,94 @@
+#include <wordle/Constraints.h>
+#include <wordle/Isa.h>
+#include <wordle/WordColumns.h>
+#include <wordle/parseDict.h>
+#include <wordle/parsePattern.h>
+#include <wordle/stateFromWord.h>
+#include <wordle_util.h>
+
+#include <doctest.h>
+
+#include <cstdint>
+#include <fstream>
+#include <vector>
+
+namespace wordle {
+
+TEST_CASE("WordColumns") {
+    auto words = std::vector<Word>{"gouge"_word, "jeans"_word, "shark"_word, "llama"_word};
+    auto columns = WordColumns(words);
+    REQUIRE(columns.size() == words.size());
+
+    for (size_t i = 0; i < NumCharacters; ++i) {
+        REQUIRE(reinterpret_cast<uintptr_t>(columns.column(i)) % WordColumns::BlockSize == 0);
+        REQUIRE(columns.columnPointers()[i] == columns.column(i));
+    }
+    for (size_t idx = 0; idx < words.size(); ++idx) {
+        REQUIRE(columns.word(idx) == words[idx]);
+    }
+    REQUIRE(columns.column(2)[1] == 'a' - 'a');
+    REQUIRE(columns.letterMasks()[3] == ((1U << ('l' - 'a')) | (1U << ('a' - 'a')) | (1U << ('m' - 'a'))));
+
+    auto empty = WordColumns(std::vector<Word>());
+    REQUIRE(empty.size() == 0);
+    REQUIRE(empty.filter(Constraints()).empty());
+}
+
+TEST_CASE("WordColumns-filter") {
+    auto fin = std::ifstream(WORDLE_DATA_DIR "/data/en_allowed.txt");
+    auto words = parseDict(fin);
+    REQUIRE(words.size() == 12972);
+    auto columns = WordColumns(words);
+
+    // clues with and without repeated letters, all states come from real games
+    auto clues = std::vector<Constraints>();
+    for (auto correctWord : {"gouge"_word, "jeans"_word, "knoll"_word, "pleat"_word, "solar"_word}) {
+        auto allClues = Constraints();
+        for (auto guessWord : {"raise"_word, "zanza"_word, "stele"_word, "abaca"_word, "pills"_word}) {
+            auto constraints = Constraints();
+            constraints.add(guessWord, stateFromWord(correctWord, guessWord));
+            clues.push_back(constraints);
+            allClues.add(guessWord, stateFromWord(correctWord, guessWord));
+            clues.push_back(allClues);
+        }
+    }
+    clues.emplace_back();
+    clues.back().add("abcde"_word, "02200"_state);
+
+    // maximum counts above 0, and patterns
+    clues.emplace_back();
+    clues.back().add("geese"_word, "20100"_state);
+    for (auto const* pattern : {"?a??e +r -st", "+ee", "s???? -aeiou", "+lll"}) {
+        clues.push_back(parsePattern(pattern));
+    }
+    clues.emplace_back();
+    clues.back().addMaxCount('l' - 'a', 1);
+    clues.back().addMinCount('l' - 'a', 1);
+
+    // nothing passes, and everything passes
+    clues.emplace_back();
+    clues.back().add("abcde"_word, "02200"_state);
+    clues.back().add("abcde"_word, "00000"_state);
+    REQUIRE(!clues.back().isSatisfiable());
+    clues.emplace_back();
+
+    auto previousIsa = activeIsa();
+    for (auto isa : {Isa::scalar, Isa::sse42, Isa::avx2, Isa::avx512}) {
+        if (!isSupported(isa)) {
+            continue;
+        }
+        forceIsa(isa);
+        for (auto const& clue : clues) {
+            auto expected = std::vector<uint32_t>();
+            for (size_t idx = 0; idx < words.size(); ++idx) {
+                if (clue(words[idx])) {
+                    expected.push_back(static_cast<uint32_t>(idx));
+                }
+            }
+            REQUIRE(columns.filter(clue) == expected);
+        }
+    }
+    forceIsa(previousIsa);
+}
+
+} // namespace wordle
@@ -0,0 +1,114 @@
+#include <wordle/FeedbackTable.h>
+#include <wordle/WordDatabase.h>
+#include <wordle/solve.h>
+#include <wordle_util.h>
+
+#include <doctest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+namespace wordle {
+
+TEST_CASE("WordDatabase") {
+    auto allowedWords = std::vector<Word>{"bough"_word, "raise"_word, "gouge"_word, "zanza"_word};
+    auto correctWords = std::vector<Word>{"gouge"_word, "jeans"_word, "zanza"_word};
+
+    auto file = std::filesystem::temp_directory_path() / "wordle-WordDatabaseTest.wdb";
+    WordDatabase::write(file, allowedWords, correctWords);
+    auto database = WordDatabase(file);
+
+    CHECK(database.allowed().toVector() == allowedWords);
+    CHECK(database.correct().toVector() == correctWords);
+    CHECK(database.contentHash() == FeedbackTable::contentHash(allowedWords, correctWords));
+
+    CHECK(database.correctToAllowed(0) == 2);
+    CHECK(database.correctToAllowed(1) == WordDatabase::NotAllowed);
+    CHECK(database.correctToAllowed(2) == 3);
+
+    // cut off the last byte
+    auto size = std::filesystem::file_size(file);
+    std::filesystem::resize_file(file, size - 1);
+    CHECK_THROWS_AS(WordDatabase{file}, std::runtime_error);
+
+    // a text file is not a database
+    {
+        auto fout = std::ofstream(file);
+        fout << "cigar\nrebut\n";
+    }
+    CHECK_THROWS_AS(WordDatabase{file}, std::runtime_error);
+
+    std::filesystem::remove(file);
+}
+
+TEST_CASE("WordDatabase-corrupt") {
+    auto allowedWords = std::vector<Word>{"bough"_word, "raise"_word, "gouge"_word, "zanza"_word};
+    auto correctWords = std::vector<Word>{"gouge"_word, "jeans"_word, "zanza"_word};
+    auto file = std::filesystem::temp_directory_path() / "wordle-WordDatabaseTest-corrupt.wdb";
+
+    // the arrays start after the 32 byte header: allowed words, correct words, correctToAllowed
+    auto constexpr HeaderSize = size_t(32);
+    auto correctWordOffset = [&](size_t correctIdx) {
+        return HeaderSize + sizeof(uint32_t) * (allowedWords.size() + correctIdx);
+    };
+    auto correctToAllowedOffset = [&](size_t correctIdx) {
+        return HeaderSize + sizeof(uint32_t) * (allowedWords.size() + correctWords.size() + correctIdx);
+    };
+
+    // writes a valid database, then overwrites the uint32_t at offset
+    auto writeWith = [&](size_t offset, uint32_t value) {
+        WordDatabase::write(file, allowedWords, correctWords);
+        auto f = std::fstream(file, std::ios::in | std::ios::out | std::ios::binary);
+        f.seekp(static_cast<std::streamoff>(offset));
+        f.write(reinterpret_cast<char const*>(&value), sizeof(value));
+    };
+
+    // unchanged values are fine
+    writeWith(correctToAllowedOffset(0), 2);
+    CHECK(WordDatabase(file).correctToAllowed(0) == 2);
+    writeWith(correctToAllowedOffset(1), WordDatabase::NotAllowed);
+    CHECK(WordDatabase(file).correctToAllowed(1) == WordDatabase::NotAllowed);
+
+    // 'z' + 1 as the last letter of gouge
+    auto word = "gouge"_word;
+    word.set(4, 26);
+    writeWith(HeaderSize + sizeof(uint32_t) * 2, word.bits());
+    CHECK_THROWS_AS(WordDatabase{file}, std::runtime_error);
+
+    // bits above the 5 letters
+    writeWith(correctWordOffset(1), "jeans"_word.bits() | (1U << 31U));
+    CHECK_THROWS_AS(WordDatabase{file}, std::runtime_error);
+
+    // index past the allowed words
+    writeWith(correctToAllowedOffset(2), static_cast<uint32_t>(allowedWords.size()));
+    CHECK_THROWS_AS(WordDatabase{file}, std::runtime_error);
+
+    // index of a different word
+    writeWith(correctToAllowedOffset(0), 1);
+    CHECK_THROWS_AS(WordDatabase{file}, std::runtime_error);
+
+    std::filesystem::remove(file);
+}
+
+TEST_CASE("WordDatabase-dictionary") {
+    auto [allowedWords, correctWords] = readWordLists(WORDLE_DATA_DIR "/data/at");
+
+    auto file = std::filesystem::temp_directory_path() / "wordle-WordDatabaseTest-at.wdb";
+    WordDatabase::write(file, allowedWords, correctWords);
+    auto database = WordDatabase(file);
+
+    // exactly what the search would use after loading the text files
+    REQUIRE(database.allowed().toVector() == allowedWords);
+    REQUIRE(database.correct().toVector() == correctWords);
+    for (size_t correctIdx = 0; correctIdx < correctWords.size(); ++correctIdx) {
+        auto allowedIdx = database.correctToAllowed(correctIdx);
+        if (allowedIdx != WordDatabase::NotAllowed) {
+            REQUIRE(allowedWords[allowedIdx] == correctWords[correctIdx]);
+        }
+    }
+
+    std::filesystem::remove(file);
+}
+
+} // namespace wordle
@@ -0,0 +1,64 @@
+#include <wordle/Constraints.h>
+#include <wordle/WordIndex.h>
+#include <wordle/parseDict.h>
+#include <wordle/parsePattern.h>
+#include <wordle/stateFromWord.h>
+#include <wordle_util.h>
+
+#include <doctest.h>
+
+#include <cstdint>
+#include <fstream>
+#include <vector>
+
+namespace wordle {
+
+TEST_CASE("WordIndex") {
+    auto words = std::vector<Word>{"gouge"_word, "jeans"_word, "geese"_word, "llama"_word};
+    auto index = WordIndex(words);
+    REQUIRE(index.size() == 4);
+    REQUIRE(index.numBlocks() == 1);
+    CHECK(index.letterAt(0, 'g' - 'a')[0] == 0b0101);
+    CHECK(index.letterAt(4, 'e' - 'a')[0] == 0b0101);
+    CHECK(index.atLeast('e' - 'a', 1)[0] == 0b0111);
+    CHECK(index.atLeast('e' - 'a', 2)[0] == 0b0100);
+    CHECK(index.atLeast('e' - 'a', 3)[0] == 0b0100);
+    CHECK(index.atLeast('e' - 'a', 4)[0] == 0);
+
+    CHECK(index.query(Constraints()) == std::vector<uint32_t>{0, 1, 2, 3});
+    CHECK(index.query(parsePattern("g???? -o")) == std::vector<uint32_t>{2});
+    CHECK(index.query(parsePattern("a???? b????")).empty());
+
+    CHECK(WordIndex(std::vector<Word>()).query(Constraints()).empty());
+}
+
+TEST_CASE("WordIndex-query") {
+    auto fin = std::ifstream(WORDLE_DATA_DIR "/data/en_allowed.txt");
+    auto words = parseDict(fin);
+    REQUIRE(words.size() == 12972);
+    auto index = WordIndex(words);
+
+    auto queries = std::vector<Constraints>();
+    for (auto pattern : {"?a??e +r -st", "", "+ee -a", "s???? +s", "?????", "-aeiou", "+aeiou", "e???e", "q???? -u"}) {
+        queries.push_back(parsePattern(pattern));
+    }
+    for (auto correctWord : {"gouge"_word, "jeans"_word, "knoll"_word, "eerie"_word}) {
+        auto constraints = Constraints();
+        for (auto guessWord : {"raise"_word, "stele"_word, "abaca"_word, "pills"_word}) {
+            constraints.add(guessWord, stateFromWord(correctWord, guessWord));
+            queries.push_back(constraints);
+        }
+    }
+
+    for (auto const& constraints : queries) {
+        auto expected = std::vector<uint32_t>();
+        for (size_t idx = 0; idx < words.size(); ++idx) {
+            if (constraints(words[idx])) {
+                expected.push_back(static_cast<uint32_t>(idx));
+            }
+        }
+        REQUIRE(index.query(constraints) == expected);
+    }
+}
+
+} // namespace wordle
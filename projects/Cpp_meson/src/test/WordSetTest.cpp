@@ -0,0 +1,76 @@
+#include <wordle/WordSet.h>
+
+#include <doctest.h>
+
+#include <vector>
+
+namespace wordle {
+
+TEST_CASE("WordSet") {
+    auto ws = WordSet();
+    CHECK(ws.empty());
+    CHECK(ws.size() == 0);
+
+    ws.insert(0);
+    ws.insert(63);
+    ws.insert(64);
+    ws.insert(WordSet::MaxWords - 1);
+    CHECK(!ws.empty());
+    CHECK(ws.size() == 4);
+    CHECK(ws.contains(63));
+    CHECK(ws.contains(64));
+    CHECK(!ws.contains(1));
+
+    auto indices = std::vector<size_t>();
+    ws.forEach([&](size_t idx) {
+        indices.push_back(idx);
+    });
+    CHECK(indices == std::vector<size_t>{0, 63, 64, WordSet::MaxWords - 1});
+
+    ws.erase(63);
+    CHECK(!ws.contains(63));
+    CHECK(ws.size() == 3);
+}
+
+TEST_CASE("WordSet-operators") {
+    auto a = WordSet();
+    auto b = WordSet();
+    for (size_t i = 0; i < 100; ++i) {
+        if (i % 2 == 0) {
+            a.insert(i);
+        }
+        if (i % 3 == 0) {
+            b.insert(i);
+        }
+    }
+
+    auto both = a & b;
+    CHECK(both.size() == 17); // 0, 6, ..., 96
+    CHECK(a.intersectionSize(b) == both.size());
+    CHECK(both.contains(96));
+    CHECK(!both.contains(2));
+
+    auto any = a | b;
+    CHECK(any.size() == 50 + 34 - 17);
+
+    CHECK(both != a);
+    a &= b;
+    CHECK(both == a);
+}
+
+TEST_CASE("WordSet-hash") {
+    auto a = WordSet();
+    CHECK(a.hash() == 0);
+
+    a.insert(3);
+    a.insert(1000);
+    CHECK(a.hash() == (WordSet::wordKey(3) ^ WordSet::wordKey(1000)));
+
+    auto b = WordSet();
+    b.insert(1000);
+    CHECK(a.hash() != b.hash());
+    b.insert(3);
+    CHECK(a.hash() == b.hash());
+}
+
+} // namespace wordle
@@ -0,0 +1,51 @@
+#include <wordle/embeddedDictionaries.h>
+#include <wordle/solve.h>
+
+#include <doctest.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace wordle {
+
+// Without -Dembed_dictionaries=true there's nothing embedded, then only the error is checked.
+TEST_CASE("embeddedDictionaries") {
+    auto dictionaries = embeddedDictionaries();
+
+    // these names are documented in the help text and in meson_options.txt
+    auto names = std::vector<std::string>();
+    for (size_t i = 0; i < dictionaries.m_size; ++i) {
+        names.emplace_back(dictionaries.m_dictionaries[i].m_name);
+    }
+    CHECK((names.empty() || names == std::vector<std::string>{"en", "de", "at"}));
+
+    for (size_t i = 0; i < dictionaries.m_size; ++i) {
+        auto const& embedded = dictionaries.m_dictionaries[i];
+        auto [allowedWords, correctWords] = readWordLists(WORDLE_DATA_DIR "/data/" + std::string(embedded.m_name));
+
+        REQUIRE(findEmbeddedDictionary(embedded.m_name) == &embedded);
+        REQUIRE(embedded.m_numAllowed == allowedWords.size());
+        REQUIRE(embedded.m_numCorrect == correctWords.size());
+        CHECK(std::equal(allowedWords.begin(), allowedWords.end(), embedded.m_allowedWords));
+        CHECK(std::equal(correctWords.begin(), correctWords.end(), embedded.m_correctWords));
+    }
+
+    // the embedded german words are the same as the ones in the repository's dictionaries, and in the same order
+    if (findEmbeddedDictionary("de") != nullptr) {
+        auto dict = loadDictionary("embedded:de");
+        auto [allowedWords, correctWords] = readWordLists(WORDLE_DATA_DIR "/../../dictionaries/de");
+        CHECK(dict.m_allowedWords == allowedWords);
+        CHECK(dict.m_correctWords == correctWords);
+        REQUIRE(dict.m_correctIds.size() == correctWords.size());
+        for (size_t correctIdx = 0; correctIdx < correctWords.size(); ++correctIdx) {
+            CHECK(dict.word(dict.m_correctIds[correctIdx]) == correctWords[correctIdx]);
+        }
+    }
+
+    CHECK(findEmbeddedDictionary("does-not-exist") == nullptr);
+    CHECK_THROWS_AS(loadDictionary("embedded:does-not-exist"), std::runtime_error);
+}
+
+} // namespace wordle
@@ -4,6 +4,7 @@
 #include <doctest.h>
 
 #include <fstream>
+#include <stdexcept>
 
 namespace wordle {
 
@@ -17,4 +18,33 @@ TEST_CASE("parseDict") {
     CHECK(words.back() == "zymic"_word);
 }
 
+TEST_CASE("parseDict_file") {
+    auto fin = std::ifstream(WORDLE_DATA_DIR "/data/at_allowed.txt");
+    auto fromStream = wordle::parseDict(fin);
+    auto fromFile = wordle::parseDictFile(WORDLE_DATA_DIR "/data/at_allowed.txt");
+    REQUIRE(!fromFile.empty());
+    CHECK(fromStream == fromFile);
+
+    CHECK_THROWS_AS(wordle::parseDictFile(WORDLE_DATA_DIR "/data/does_not_exist.txt"), std::runtime_error);
+}
+
+TEST_CASE("parseDict_filter") {
+    // too short, too long, digits, non-ASCII and duplicates in any case are skipped
+    auto words = wordle::parseDict("cigar\nCIGAR\r\nrebut sissy\tabc\nabcdef\nab1de\nm\xc3\xa4rz\n\nHumph\vaback\fcigar");
+    REQUIRE(words.size() == 5);
+    CHECK(words[0] == "cigar"_word);
+    CHECK(words[1] == "rebut"_word);
+    CHECK(words[2] == "sissy"_word);
+    CHECK(words[3] == "humph"_word);
+    CHECK(words[4] == "aback"_word);
+
+    // last word without a trailing newline
+    words = wordle::parseDict("  zymic");
+    REQUIRE(words.size() == 1);
+    CHECK(words[0] == "zymic"_word);
+
+    CHECK(wordle::parseDict("").empty());
+    CHECK(wordle::parseDict("zymics").empty());
+}
+
 } // namespace wordle
@@ -0,0 +1,37 @@
+#include <wordle/parsePattern.h>
+#include <wordle_util.h>
+
+#include <doctest.h>
+
+#include <stdexcept>
+
+namespace wordle {
+
+TEST_CASE("parsePattern") {
+    auto constraints = parsePattern("?a??e +r -st");
+    REQUIRE(constraints.isSatisfiable());
+    CHECK(constraints("rakee"_word));
+    CHECK(constraints("payer"_word) == false);
+    CHECK(constraints("raxxe"_word));
+    CHECK(constraints("xaxxe"_word) == false);
+    CHECK(constraints("rasxe"_word) == false);
+    CHECK(constraints.minCount('e' - 'a') == 1);
+    CHECK(constraints.maxCount('s' - 'a') == 0);
+
+    // repeated letters and the same letter at several positions
+    CHECK(parsePattern("+ee")("eexxx"_word));
+    CHECK(parsePattern("+ee")("exxxx"_word) == false);
+    CHECK(parsePattern("e???e")("exxxe"_word));
+    CHECK(parsePattern("e???e").minCount('e' - 'a') == 2);
+    CHECK(parsePattern("  e???e   -x ")("eyyye"_word));
+
+    CHECK(parsePattern("")("zzzzz"_word));
+    CHECK(parsePattern("a???? b????").isSatisfiable() == false);
+    CHECK(parsePattern("a???? -a").isSatisfiable() == false);
+
+    CHECK_THROWS_AS(parsePattern("?a?e"), std::runtime_error);
+    CHECK_THROWS_AS(parsePattern("?A??e"), std::runtime_error);
+    CHECK_THROWS_AS(parsePattern("+r1"), std::runtime_error);
+}
+
+} // namespace wordle
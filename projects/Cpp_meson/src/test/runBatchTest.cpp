@@ -0,0 +1,112 @@
+#include <wordle/runBatch.h>
+
+#include <doctest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace wordle {
+
+namespace {
+
+std::vector<std::string> lines(std::string const& text) {
+    auto in = std::istringstream(text);
+    auto result = std::vector<std::string>();
+    auto line = std::string();
+    while (std::getline(in, line)) {
+        result.push_back(line);
+    }
+    return result;
+}
+
+bool endsWith(std::string const& str, std::string const& suffix) {
+    return str.size() >= suffix.size() && str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+} // namespace
+
+TEST_CASE("runBatch") {
+    auto prefix = (std::filesystem::temp_directory_path() / "wordle-runBatchTest").string();
+    {
+        auto allowed = std::ofstream(prefix + "_allowed.txt");
+        allowed << "bough\nraise\ngouge\nzanza\nshark\njeans\ncigar\nrebut\n";
+        auto correct = std::ofstream(prefix + "_correct.txt");
+        correct << "gouge\njeans\nshark\ncigar\nrebut\n";
+    }
+    auto dict = loadDictionary(prefix);
+
+    auto in = std::istringstream("shark22222\n"
+                                 "\n"
+                                 "~~~~~00000\n"
+                                 "cigar22222\n"
+                                 "gouge00000 shark22222\n"
+                                 "jeans22222 shark22222\n"
+                                 "rebut22222\n");
+    auto out = std::ostringstream();
+    auto stats = runBatch(dict, in, out, 2, std::nullopt);
+
+    // one answer per line, in input order
+    auto answers = lines(out.str());
+    REQUIRE(answers.size() == 7);
+    CHECK(endsWith(answers[0], " shark"));
+    CHECK(answers[1].find("error") == std::string::npos);
+    CHECK(answers[2].rfind("error: invalid letter", 0) == 0);
+    CHECK(endsWith(answers[3], " cigar"));
+    CHECK(answers[4] == answers[0]);
+    CHECK(answers[5].rfind("error: no correct word", 0) == 0);
+    CHECK(endsWith(answers[6], " rebut"));
+
+    // lines 0 and 4 leave the same word, errors aren't solved at all
+    CHECK(stats.m_numLines == 7);
+    CHECK(stats.m_numUnique == 4);
+
+    // sets are only solved once, also when the duplicates are in different chunks
+    auto text = std::string();
+    for (size_t i = 0; i < 600; ++i) {
+        text += i % 3 == 0 ? "shark22222\n" : i % 3 == 1 ? "cigar22222\n" : "weary0010\n";
+    }
+    in = std::istringstream(text);
+    out = std::ostringstream();
+    stats = runBatch(dict, in, out, 2, std::nullopt);
+    answers = lines(out.str());
+    REQUIRE(answers.size() == 600);
+    for (size_t i = 0; i < answers.size(); ++i) {
+        if (i % 3 == 0) {
+            CHECK(endsWith(answers[i], " shark"));
+        } else if (i % 3 == 1) {
+            CHECK(endsWith(answers[i], " cigar"));
+        } else {
+            CHECK(answers[i].rfind("error: ", 0) == 0);
+        }
+    }
+    CHECK(stats.m_numLines == 600);
+    CHECK(stats.m_numUnique == 2);
+
+    // queries are answered directly, they aren't solved
+    in = std::istringstream("query ?o??e\n"
+                            "shark22222\n"
+                            "query +q\n"
+                            "query ?o\n"
+                            "query ???r? shark00000\n");
+    out = std::ostringstream();
+    stats = runBatch(dict, in, out, 2, std::nullopt);
+    answers = lines(out.str());
+    REQUIRE(answers.size() == 5);
+    CHECK(answers[0] == "1 gouge");
+    CHECK(endsWith(answers[1], " shark"));
+    CHECK(answers[2] == "0");
+    CHECK(answers[3].rfind("error: invalid pattern part", 0) == 0);
+    CHECK(answers[4] == "0");
+    CHECK(stats.m_numLines == 5);
+    CHECK(stats.m_numUnique == 1);
+
+    for (auto const* suffix : {"_allowed.txt", "_correct.txt", "_feedback.cache"}) {
+        std::filesystem::remove(prefix + suffix);
+    }
+}
+
+} // namespace wordle
@@ -0,0 +1,77 @@
+#include <wordle/parseDict.h>
+#include <wordle/solve.h>
+
+#include <doctest.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <optional>
+#include <vector>
+
+// This replaces the global operator new and delete, which would affect every other test. So it is built into its own
+// executable, test-wordle-allocations.
+
+namespace {
+
+// Counts all allocations of this executable, so tests can check that some code doesn't allocate.
+std::atomic<size_t> numAllocations{};
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    ++numAllocations;
+    if (auto* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t /*size*/) noexcept {
+    std::free(ptr);
+}
+
+namespace wordle {
+
+TEST_CASE("solve-no-allocations") {
+    auto fin = std::ifstream(WORDLE_DATA_DIR "/data/at_allowed.txt");
+    auto words = parseDict(fin);
+
+    // small enough that a full depth 3 search is quick
+    auto allowedWords = std::vector<Word>(words.begin(), words.begin() + 300);
+    auto correctWords = std::vector<Word>();
+    auto correctIds = std::vector<WordId>();
+    for (size_t id = 0; id < allowedWords.size(); id += 10) {
+        correctWords.push_back(allowedWords[id]);
+        correctIds.push_back(static_cast<WordId>(id));
+    }
+    auto feedback = FeedbackTable(allowedWords, correctWords);
+    // small buckets get masks too, so counting with them is covered
+    auto masks = FeedbackMasks(feedback, 2, 8);
+    auto dict = Dictionary{allowedWords, correctWords, correctIds, std::move(feedback), std::move(masks),
+                           WordColumns(correctWords), WordIndex(allowedWords)};
+
+    auto remaining = WordSet();
+    for (size_t correctIdx = 0; correctIdx < correctWords.size(); ++correctIdx) {
+        remaining.insert(correctIdx);
+    }
+    auto transpositions = TranspositionTable<Result>(1U << 12U);
+
+    // the first search on this thread sets up its buffers
+    auto warmup = solve(dict, remaining, transpositions, 3, std::nullopt, false, false);
+
+    auto before = numAllocations.load();
+    auto result = solve(dict, remaining, transpositions, 3, std::nullopt, false, false);
+    auto numSearchAllocations = numAllocations.load() - before;
+
+    CHECK(numSearchAllocations == 0);
+    CHECK(result.m_guessId == warmup.m_guessId);
+    CHECK(result.m_fitness == warmup.m_fitness);
+}
+
+} // namespace wordle
@@ -0,0 +1,234 @@
+#include <wordle/parseDict.h>
+#include <wordle/solve.h>
+#include <wordle_util.h>
+
+#include <doctest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+namespace wordle {
+
+namespace {
+
+Fitness referenceMini(Dictionary const& dict,
+                      std::vector<size_t> const& words,
+                      Fitness const& path,
+                      size_t currentDepth,
+                      size_t maxDepth);
+
+// Plain minimax over all guesses and all buckets, without pruning, transposition table or threads. Same values as the
+// search: path holds the bucket sizes of the levels above.
+Fitness referenceMaxi(Dictionary const& dict,
+                      std::vector<size_t> const& words,
+                      size_t guessId,
+                      Fitness const& path,
+                      size_t currentDepth,
+                      size_t maxDepth) {
+    auto buckets = std::vector<std::vector<size_t>>(NumStateCodes);
+    for (auto correctIdx : words) {
+        auto code = dict.m_feedback(guessId, correctIdx);
+        if (code != AllCorrectStateCode) {
+            buckets[code].push_back(correctIdx);
+        }
+    }
+
+    if (currentDepth == maxDepth - 1) {
+        auto value = path;
+        value[currentDepth] = 0;
+        for (auto const& bucket : buckets) {
+            value[currentDepth] = std::max(value[currentDepth], bucket.size());
+        }
+        return value;
+    }
+
+    auto value = Fitness::mini();
+    for (auto const& bucket : buckets) {
+        if (!bucket.empty()) {
+            auto childPath = path;
+            childPath[currentDepth] = bucket.size();
+            value = std::max(value, referenceMini(dict, bucket, childPath, currentDepth + 1, maxDepth));
+        }
+    }
+    return value;
+}
+
+Fitness referenceMini(Dictionary const& dict,
+                      std::vector<size_t> const& words,
+                      Fitness const& path,
+                      size_t currentDepth,
+                      size_t maxDepth) {
+    if (words.size() == 1) {
+        auto value = path;
+        for (auto i = currentDepth; i < value.size(); ++i) {
+            value[i] = 0;
+        }
+        return value;
+    }
+    auto value = Fitness::maxi();
+    for (size_t guessId = 0; guessId < dict.m_allowedWords.size(); ++guessId) {
+        value = std::min(value, referenceMaxi(dict, words, guessId, path, currentDepth, maxDepth));
+    }
+    return value;
+}
+
+// Words that differ in a single letter are hard to tell apart, so the search has to go deep. withMasks gives buckets with 6
+// or more words a mask, and counts nodes with 24 or more words with them. Some of these still need the scan.
+Dictionary smallDictionary(bool withMasks) {
+    auto correctWords = parseDict("sower pound round hatch light watch found night power waste catch mound paste might sound "
+                                  "eight caste lower latch wight haste patch bound taste sight tower fight cower wound right "
+                                  "baste tight mower batch hound match rower");
+    auto allowedWords = correctWords;
+    for (auto word : parseDict("chomp flint brawl dusky whelp frump gawks")) {
+        allowedWords.push_back(word);
+    }
+    auto correctIds = std::vector<WordId>();
+    for (size_t id = 0; id < correctWords.size(); ++id) {
+        correctIds.push_back(static_cast<WordId>(id));
+    }
+    auto feedback = FeedbackTable(allowedWords, correctWords);
+    auto masks = withMasks ? FeedbackMasks(feedback, 6, 24) : FeedbackMasks();
+    return Dictionary{allowedWords, correctWords, correctIds, std::move(feedback), std::move(masks),
+                      WordColumns(correctWords), WordIndex(allowedWords)};
+}
+
+// All correct words, and a few pseudo random subsets of them.
+std::vector<WordSet> remainingWordSets(Dictionary const& dict) {
+    auto sets = std::vector<WordSet>(6);
+    for (size_t correctIdx = 0; correctIdx < dict.m_correctWords.size(); ++correctIdx) {
+        sets[0].insert(correctIdx);
+        for (size_t i = 1; i < sets.size(); ++i) {
+            if (WordSet::wordKey(correctIdx * sets.size() + i) % 3 != 0) {
+                sets[i].insert(correctIdx);
+            }
+        }
+    }
+    return sets;
+}
+
+std::vector<size_t> toVector(WordSet const& words) {
+    auto v = std::vector<size_t>();
+    words.forEach([&](size_t correctIdx) {
+        v.push_back(correctIdx);
+    });
+    return v;
+}
+
+Fitness referenceValue(Dictionary const& dict, WordSet const& remaining, size_t maxDepth) {
+    return referenceMini(dict, toVector(remaining), Fitness::maxi(), 0, maxDepth);
+}
+
+// The result has the reference value, and its guess really achieves it.
+void checkResult(Dictionary const& dict,
+                 WordSet const& remaining,
+                 Result const& result,
+                 size_t maxDepth,
+                 Fitness const& expected) {
+    CHECK(result.m_fitness == expected);
+    CHECK(result.m_bound == Bound::exact);
+    REQUIRE(result.m_guessId < dict.m_allowedWords.size());
+    CHECK(referenceMaxi(dict, toVector(remaining), result.m_guessId, Fitness::maxi(), 0, maxDepth) == expected);
+}
+
+} // namespace
+
+TEST_CASE("parseWordAndState") {
+    auto [word, state] = parseWordAndState("weary00102");
+    CHECK(word == "weary"_word);
+    CHECK(state[0] == St::not_included);
+    CHECK(state[2] == St::wrong_spot);
+    CHECK(state[4] == St::correct);
+
+    // letters outside a-z would corrupt the packed word
+    CHECK_THROWS_AS(parseWordAndState("~~~~~00000"), std::runtime_error);
+    CHECK_THROWS_AS(parseWordAndState("WEARY00102"), std::runtime_error);
+    CHECK_THROWS_AS(parseWordAndState("wea{y00102"), std::runtime_error);
+    CHECK_THROWS_AS(parseWordAndState("weary00103"), std::runtime_error);
+    CHECK_THROWS_AS(parseWordAndState("weary0010"), std::runtime_error);
+}
+
+TEST_CASE("loadDictionary-wordIds") {
+    auto prefix = (std::filesystem::temp_directory_path() / "wordle-solveTest").string();
+    {
+        auto allowed = std::ofstream(prefix + "_allowed.txt");
+        allowed << "bough\nraise\ngouge\nzanza\nshark\n";
+        // jeans is not allowed, it's added to the allowed words
+        auto correct = std::ofstream(prefix + "_correct.txt");
+        correct << "gouge\njeans\nshark\n";
+    }
+
+    auto dict = loadDictionary(prefix);
+    REQUIRE(dict.m_allowedWords.size() == 6);
+    CHECK(dict.m_allowedWords.back() == "jeans"_word);
+    REQUIRE(dict.m_correctIds.size() == dict.m_correctWords.size());
+    for (size_t correctIdx = 0; correctIdx < dict.m_correctWords.size(); ++correctIdx) {
+        CHECK(dict.word(dict.m_correctIds[correctIdx]) == dict.m_correctWords[correctIdx]);
+        // entering the correct word is all correct
+        CHECK(dict.m_feedback(dict.m_correctIds[correctIdx], correctIdx) == AllCorrectStateCode);
+    }
+
+    // a single remaining word is guessed directly
+    auto remaining = WordSet();
+    remaining.insert(1);
+    auto transpositions = TranspositionTable<Result>(1U << 10U);
+    auto result = solve(dict, remaining, transpositions, 2, std::nullopt, false, false);
+    CHECK(dict.word(result.m_guessId) == dict.m_correctWords[1]);
+
+    for (auto const* suffix : {"_allowed.txt", "_correct.txt", "_feedback.cache"}) {
+        std::filesystem::remove(prefix + suffix);
+    }
+}
+
+TEST_CASE("solve-reference") {
+    // same words, the leaves either scan or count with the masks
+    auto scanDict = smallDictionary(false);
+    auto maskDict = smallDictionary(true);
+
+    // more threads than cores is fine, they still interleave
+    auto pool = ankerl::parallel::ThreadPool(4);
+    auto transpositions = TranspositionTable<Result>(1U << 12U);
+    for (auto const& remaining : remainingWordSets(scanDict)) {
+        for (size_t maxDepth = 1; maxDepth <= 3; ++maxDepth) {
+            auto expected = referenceValue(scanDict, remaining, maxDepth);
+
+            for (auto const* dict : {&scanDict, &maskDict}) {
+                auto result = solve(*dict, remaining, transpositions, maxDepth, std::nullopt, false, nullptr);
+                checkResult(*dict, remaining, result, maxDepth, expected);
+
+                // threads race differently each time
+                for (size_t i = 0; i < 3; ++i) {
+                    result = solve(*dict, remaining, transpositions, maxDepth, std::nullopt, false, &pool);
+                    checkResult(*dict, remaining, result, maxDepth, expected);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("solve-reference-deadline") {
+    auto dict = smallDictionary(true);
+    auto pool = ankerl::parallel::ThreadPool(4);
+    auto transpositions = TranspositionTable<Result>(1U << 12U);
+    auto remaining = remainingWordSets(dict)[0];
+    auto expectedDepth1 = referenceValue(dict, remaining, 1);
+    auto expectedDepth3 = referenceValue(dict, remaining, 3);
+    for (auto* searchPool : {static_cast<ankerl::parallel::ThreadPool*>(nullptr), &pool}) {
+        // the first depth is always searched, the deadline stops the next one
+        auto deadline = std::chrono::steady_clock::now();
+        auto result = solve(dict, remaining, transpositions, 3, deadline, false, searchPool);
+        checkResult(dict, remaining, result, 1, expectedDepth1);
+
+        // enough time for all depths
+        deadline = std::chrono::steady_clock::now() + std::chrono::hours(1);
+        result = solve(dict, remaining, transpositions, 3, deadline, false, searchPool);
+        checkResult(dict, remaining, result, 3, expectedDepth3);
+    }
+}
+
+} // namespace wordle
@@ -3,6 +3,20 @@
 
 namespace wordle {
 
+// packed words, and the SWAR helpers stateCodeFromWord() is built on
+static_assert(sizeof(Word) == sizeof(uint32_t));
+static_assert("abcde"_word.bits() == (0U | 1U << 5U | 2U << 10U | 3U << 15U | 4U << 20U));
+static_assert("abcde"_word["abcde"_word.size() - 1] == 'e' - 'a');
+static_assert("abcde"_word != "abcdz"_word);
+static_assert(Word::fromBits("zebra"_word.bits()) == "zebra"_word);
+static_assert(matchingLetters("abcde"_word, "abxdx"_word) == 0b00000'00001'00000'00001'00001U);
+static_assert(matchingLetters("zzzzz"_word, "zzzzz"_word) == Word::LowBits);
+static_assert(lettersEqualTo("llama"_word, 'l' - 'a') == 0b00000'00000'00000'00001'00001U);
+static_assert(countLetters(lettersEqualTo("llama"_word, 'a' - 'a')) == 2);
+static_assert(countLetters(lettersEqualTo("zzzzz"_word, 'y' - 'a')) == 0);
+static_assert(stateCodeFromWord("gouge"_word, "bough"_word) == toStateCode("02220"_state));
+static_assert(stateCodeFromWord("abcde"_word, "abcde"_word) == AllCorrectStateCode);
+
 static_assert(stateFromWord("aacde"_word, "aaaxx"_word) == "22000"_state);
 static_assert(stateFromWord("aacde"_word, "aaxxx"_word) == "22000"_state);
 static_assert(stateFromWord("abcde"_word, "aaxxx"_word) == "20000"_state);
@@ -0,0 +1,116 @@
+#include <wordle/Isa.h>
+#include <wordle/State.h>
+#include <wordle/parseDict.h>
+#include <wordle/stateFromWord.h>
+#include <wordle/statesFromWord.h>
+#include <wordle_util.h>
+
+#include <doctest.h>
+
+#include <fstream>
+#include <utility>
+#include <vector>
+
+namespace wordle {
+
+namespace {
+
+// Calculates all codes for guessWord with the given kernel, and compares them with stateFromWord().
+template <typename Kernel>
+void checkKernel(Kernel kernel, Word const& guessWord, std::vector<Word> const& correctWords) {
+    auto columns = std::array<std::vector<char>, NumCharacters>();
+    auto columnPointers = WordColumnPointers();
+    for (size_t i = 0; i < NumCharacters; ++i) {
+        for (auto const& correctWord : correctWords) {
+            columns[i].push_back(correctWord[i]);
+        }
+        columnPointers[i] = columns[i].data();
+    }
+
+    auto codes = std::vector<uint8_t>(correctWords.size());
+    kernel(guessWord, columnPointers, correctWords.size(), codes.data());
+
+    auto expectedCodes = std::vector<uint8_t>();
+    for (auto const& correctWord : correctWords) {
+        expectedCodes.push_back(toStateCode(stateFromWord(correctWord, guessWord)));
+    }
+    REQUIRE(codes == expectedCodes);
+}
+
+template <typename Kernel>
+void checkKernel(Kernel kernel) {
+    // (correct, guess) pairs from stateFromWordTest.cpp
+    auto pairs = std::vector<std::pair<Word, Word>>{
+        {"aacde"_word, "aaaxx"_word}, {"aacde"_word, "aaxxx"_word}, {"abcde"_word, "aaxxx"_word},
+        {"abcde"_word, "xaaxx"_word}, {"gouge"_word, "bough"_word}, {"gouge"_word, "lento"_word},
+        {"gouge"_word, "raise"_word}, {"jeans"_word, "ashen"_word}, {"jeans"_word, "knelt"_word},
+        {"jeans"_word, "raise"_word}, {"knoll"_word, "pills"_word}, {"lilac"_word, "apian"_word},
+        {"lilac"_word, "mambo"_word}, {"lilac"_word, "stare"_word}, {"panic"_word, "chase"_word},
+        {"panic"_word, "magic"_word}, {"panic"_word, "rocky"_word}, {"pleat"_word, "becap"_word},
+        {"pleat"_word, "model"_word}, {"pleat"_word, "stele"_word}, {"pleat"_word, "trawl"_word},
+        {"shark"_word, "zanza"_word}, {"solar"_word, "abaca"_word}, {"solar"_word, "alaap"_word},
+        {"solar"_word, "raise"_word}, {"basic"_word, "rayne"_word}, {"basic"_word, "humph"_word},
+        {"chute"_word, "rayne"_word}, {"chute"_word, "sluit"_word},
+    };
+
+    // all correct words against each guess, so the kernel sees full registers and a tail
+    auto correctWords = std::vector<Word>();
+    for (auto const& [correctWord, guessWord] : pairs) {
+        correctWords.push_back(correctWord);
+    }
+    for (auto const& [correctWord, guessWord] : pairs) {
+        checkKernel(kernel, guessWord, correctWords);
+    }
+
+    // plenty of repeated letters in the dictionary
+    auto fin = std::ifstream(WORDLE_DATA_DIR "/data/en_allowed.txt");
+    auto words = parseDict(fin);
+    REQUIRE(words.size() == 12972);
+    for (size_t i = 0; i < words.size(); i += 37) {
+        checkKernel(kernel, words[i], words);
+    }
+}
+
+} // namespace
+
+TEST_CASE("statesFromWord-scalar") {
+    checkKernel(statesFromWordScalar);
+}
+
+TEST_CASE("statesFromWord-sse42") {
+    if (!isSupported(Isa::sse42)) {
+        MESSAGE("CPU has no SSE4.2, skipping");
+        return;
+    }
+    checkKernel(statesFromWordSse42);
+}
+
+TEST_CASE("statesFromWord-avx2") {
+    if (!isSupported(Isa::avx2)) {
+        MESSAGE("CPU has no AVX2, skipping");
+        return;
+    }
+    checkKernel(statesFromWordAvx2);
+}
+
+TEST_CASE("statesFromWord-avx512") {
+    if (!isSupported(Isa::avx512)) {
+        MESSAGE("CPU has no AVX-512, skipping");
+        return;
+    }
+    checkKernel(statesFromWordAvx512);
+}
+
+TEST_CASE("statesFromWord") {
+    // dispatches to each supported kernel
+    auto previousIsa = activeIsa();
+    for (auto isa : {Isa::scalar, Isa::sse42, Isa::avx2, Isa::avx512}) {
+        if (isSupported(isa)) {
+            forceIsa(isa);
+            checkKernel(statesFromWord);
+        }
+    }
+    forceIsa(previousIsa);
+}
+
+} // namespace wordle
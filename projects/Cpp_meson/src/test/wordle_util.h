@@ -20,7 +20,7 @@ constexpr Word operator""_word(char const* str, size_t s) {
         throw std::runtime_error("size does not match");
     }
     for (size_t i = 0; i < w.size(); ++i) {
-        w[i] = str[i] - 'a';
+        w.set(i, str[i] - 'a');
     }
     return w;
 }
@@ -546,7 +546,13 @@ Result mini(Node& node, size_t currentDepth, size_t maxDepth, Fitness alpha, Fit
         auto mutex = std::mutex();
         ankerl::parallel::for_each(
             node.m_allowedWordsToEnter->begin(), node.m_allowedWordsToEnter->end(), [&](Word const& guessWord) {
-                auto value = maxi(node, guessWord, currentDepth + 1, maxDepth, alpha, beta);
+                // other threads update beta, so only read it while locked
+                auto currentBeta = Fitness::maxi();
+                {
+                    auto lock = std::lock_guard(mutex);
+                    currentBeta = beta;
+                }
+                auto value = maxi(node, guessWord, currentDepth + 1, maxDepth, alpha, currentBeta);
 
                 auto lock = std::lock_guard(mutex);
 
@@ -589,10 +595,23 @@ Result mini(Node& node, size_t currentDepth, size_t maxDepth, Fitness alpha, Fit
 // maxi: wants to find the most hard to guess "correct" word
 Result maxi(Node const& node, Word const& guessWord, size_t currentDepth, size_t maxDepth, Fitness alpha, Fitness beta) {
     Result bestValue = Result::mini();
+
+    // Correct words that produce the same state lead to exactly the same next node, so each state is evaluated only once.
+    // That also copies the node with its Preconditions once per state, instead of once per correct word.
+    auto isStateDone = std::array<bool, 3 * 3 * 3 * 3 * 3>{};
     for (Word const& correctWord : *node.m_remainingCorrectWords) {
+        auto state = stateFromWord(correctWord, guessWord);
+        auto stateCode = size_t();
+        for (auto ch : state) {
+            stateCode = stateCode * 3 + static_cast<size_t>(ch - '0');
+        }
+        if (isStateDone[stateCode]) {
+            continue;
+        }
+        isStateDone[stateCode] = true;
+
         // create information for the next node
         auto nextNode = node;
-        auto state = stateFromWord(correctWord, guessWord);
         nextNode.m_pre.addWordAndState(guessWord, state);
 
         // create a new list of remaining correct words